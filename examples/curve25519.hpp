@@ -2,21 +2,35 @@
 
 #include "montgomerycurve.hpp"
 
-class Curve25519 : public MontgomeryCurve<320>
+DEFINE_QBIGNUM_LITERAL(320);
+
+/* Curve constants are built at compile time so nothing is parsed at startup */
+namespace Curve25519Constants
+{
+    using namespace QBigNumLiterals;
+    constexpr QBigNum<320> a = 0x76d06_bn320; // Coefficient 'a'
+    constexpr QBigNum<320> p = 0x7fffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffed_bn320; // Prime modulus
+    constexpr QBigNum<320> Gx = 0x09_bn320;
+    constexpr QBigNum<320> Gy = 0x20ae19a1b8a086b4e01edd2c7748d14c923d4d7e6d7c61b229e9c5a27eced3d9_bn320;
+    constexpr QBigNum<320> n = 0x1000000000000000000000000000000014def9dea2f79cd65812631a5cf5d3ed_bn320; // order
+}
+
+/* p = 2^255 - 19, so products fold back with a multiply by 19 instead of a division */
+class Curve25519 : public MontgomeryCurve<320, QBigNumSolinas<320>>
 {
 public:
     using BigNum = QBigNum<320>;
-    using Curve = MontgomeryCurve<320>;
+    using Curve = MontgomeryCurve<320, QBigNumSolinas<320>>;
     using Point = Curve::Point;
     const Point G;
     const BigNum n;
     Curve25519()
         : Curve(
-              BigNum("0x76d06"), // Coefficient 'a'
-              BigNum("0x7fffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffed") // Prime modulus
+              Curve25519Constants::a, // Coefficient 'a'
+              Curve25519Constants::p // Prime modulus
               ),
-        G("0x09", "0x20ae19a1b8a086b4e01edd2c7748d14c923d4d7e6d7c61b229e9c5a27eced3d9"), // G
-        n("0x1000000000000000000000000000000014def9dea2f79cd65812631a5cf5d3ed") // order
+        G(Curve25519Constants::Gx, Curve25519Constants::Gy), // G
+        n(Curve25519Constants::n) // order
     {}
 
     Point operator*(const BigNum& other) const
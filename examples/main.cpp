@@ -92,68 +92,63 @@ int main()
     QBigNum<1024> h;
     h=p;
 
-    result = legendre(a, p);
-    if (result == p - 1)
+    int symbol = legendre(a, p);
+    if (!millerRabin(p))
     {
-        PRINT << "legendre1:" << "legendre(" << a << "," << p <<") ==" << result << " (quadratic residule doesn't exist)";
+        PRINT << "legendre1:" << "legendre(" << a << "," << p <<") ==" << symbol << " (67586567573 is not a prime)";
     }
-    else if (result == 1)
+    else if (symbol == -1)
     {
-        PRINT << "legendre1:" << "legendre(" << a << "," << p <<") ==" << result << " (quadratic residule exists)";
+        PRINT << "legendre1:" << "legendre(" << a << "," << p <<") ==" << symbol << " (quadratic residule doesn't exist)";
     }
-    else if (result != 0)
+    else if (symbol == 1)
     {
-        PRINT << "legendre1:" << "legendre(" << a << "," << p <<") ==" << result << " (67586567573 is not a prime)";
+        PRINT << "legendre1:" << "legendre(" << a << "," << p <<") ==" << symbol << " (quadratic residule exists)";
     }
     else
     {
-        PRINT << "legendre1:" << "legendre(" << a << "," << p <<") ==" << result;
+        PRINT << "legendre1:" << "legendre(" << a << "," << p <<") ==" << symbol;
     }
 
     /* legendre2 */
     p = 67586567603;
-    result = legendre(a, p);
-    if (result == -1 % p)
+    symbol = legendre(a, p);
+    if (symbol == -1)
     {
-        PRINT << "legendre2:" << "legendre(" << a << "," << p <<") ==" << result << " (quadratic residule doesn't exist)";
+        PRINT << "legendre2:" << "legendre(" << a << "," << p <<") ==" << symbol << " (quadratic residule doesn't exist)";
     }
-    else if (result == 1)
+    else if (symbol == 1)
     {
-        PRINT << "legendre2:" << "legendre(" << a << "," << p <<") ==" << result << " (quadratic residule exists)";
-    }
-    else if (result != 0)
-    {
-        PRINT << "legendre2:" << "legendre(" << a << "," << p <<") ==" << result << " (67586567573 is not a prime)";
+        PRINT << "legendre2:" << "legendre(" << a << "," << p <<") ==" << symbol << " (quadratic residule exists)";
     }
     else
     {
-        PRINT << "legendre2:" << "legendre(" << a << "," << p <<") ==" << result;
+        PRINT << "legendre2:" << "legendre(" << a << "," << p <<") ==" << symbol;
     }
 
     /* legendre3 */
     a = 1000000009;
-    result = legendre(a, p);
-    if (result == -1 % p)
+    symbol = legendre(a, p);
+    if (symbol == -1)
     {
-        PRINT << "legendre3:" << "legendre(" << a << "," << p <<") ==" << result << " (quadratic residule doesn't exist)";
+        PRINT << "legendre3:" << "legendre(" << a << "," << p <<") ==" << symbol << " (quadratic residule doesn't exist)";
     }
-    else if (result == 1)
+    else if (symbol == 1)
     {
-        PRINT << "legendre3:" << "legendre(" << a << "," << p <<") ==" << result << " (quadratic residule exists)";
-    }
-    else if (result != 0)
-    {
-        PRINT << "legendre3:" << "legendre(" << a << "," << p <<") ==" << result << " (67586567573 is not a prime)";
+        PRINT << "legendre3:" << "legendre(" << a << "," << p <<") ==" << symbol << " (quadratic residule exists)";
     }
     else
     {
-        PRINT << "legendre2:" << "legendre(" << a << "," << p <<") ==" << result;
+        PRINT << "legendre3:" << "legendre(" << a << "," << p <<") ==" << symbol;
     }
 
     /* legendre4 */
     a = 2 * p;
-    result = legendre(a, p);
-    PRINT << "legendre4:" << "legendre(" << a << "," << p <<") ==" << result;
+    symbol = legendre(a, p);
+    PRINT << "legendre4:" << "legendre(" << a << "," << p <<") ==" << symbol;
+
+    /* jacobi */
+    PRINT << "jacobi:" << "jacobi(1001, 9907) ==" << jacobi(1001, 9907);
 
     /* tonelli1 */
     a = 1000000009;
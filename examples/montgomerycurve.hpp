@@ -5,7 +5,8 @@
 
 #include "qbignum.hpp"
 
-template <size_t Bits>
+/* Products are reduced through Reducer, built from p. Curves with a special form prime can pick QBigNumSolinas */
+template <size_t Bits, typename Reducer = QBigNumBarrett<Bits>>
 class MontgomeryCurve
 {
 public:
@@ -47,15 +48,15 @@ public:
     };
 
     MontgomeryCurve(const BigNum &a, const BigNum &p)
-        : modulus(p), curveA(a)
+        : modulus(p), curveA(a), reducer(p)
     {
     }
 
     Point pointDouble(const Point &point) const
     {
-        const BigNum BigNum2 = BigNum(2);
-        const BigNum BigNum3 = BigNum(3);
-        const BigNum BigNumMinus1 = BigNum(-1);
+        static constexpr BigNum BigNum2 = BigNum(2);
+        static constexpr BigNum BigNum3 = BigNum(3);
+        static constexpr BigNum BigNumMinus1 = BigNum(-1);
         Point result;
         const BigNum &y = point.y;
         const BigNum &x = point.x;
@@ -67,21 +68,22 @@ public:
         }
 
         //(x * x * 3 + curveA * x * 2 + BigNum(1)) % modulus;
-        BigNum numerator = BigNum::mulMod(x, x * BigNum3, modulus);
-        numerator       += BigNum::mulMod(curveA, x * BigNum2, modulus);
+        BigNum numerator = BigNum::sqrMod(x, reducer) * BigNum3;
+        numerator       += BigNum::mulMod(curveA, x * BigNum2, reducer);
         numerator++;
         numerator       %= modulus;
         BigNum denominator = BigNum::powMod(y * BigNum2, BigNumMinus1, modulus);
-        BigNum lamb = BigNum::mulMod(numerator, denominator, modulus);
+        BigNum lamb = BigNum::mulMod(numerator, denominator, reducer);
 
         //BigNum xDouble = (lamb * lamb - x * 2 - curveA) % modulus;
         // BigNum yDouble = (-(y + lamb * (xDouble - x))) % modulus;
 
-        xResult  = BigNum::mulMod(lamb, lamb,  modulus);
-        xResult -= x * BigNum2 + curveA;
+        xResult  = BigNum::sqrMod(lamb, reducer);
+        xResult -= curveA;
+        BigNum::subMul1(xResult, x, 2);
         xResult %= modulus;
 
-        yResult  = BigNum::mulMod(lamb, (xResult - x),  modulus);
+        yResult  = BigNum::mulMod(lamb, (xResult - x), reducer);
         yResult += y;
         yResult  = -yResult;
         yResult %= modulus;
@@ -110,18 +112,18 @@ public:
 
         BigNum numerator = (y2 - y1) % modulus;
         BigNum denominator = (x2 - x1).inverseMod(modulus);
-        BigNum lamb = BigNum::mulMod(numerator, denominator, modulus);
+        BigNum lamb = BigNum::mulMod(numerator, denominator, reducer);
 
         //BigNum x3 = (lamb * lamb - x1 - x2 - curveA) % modulus;
         //BigNum y3 = (-(y1 + lamb * (x3 - x1))) % modulus;
 
-        xResult  = BigNum::mulMod(lamb, lamb, modulus);
+        xResult  = BigNum::sqrMod(lamb, reducer);
         xResult -= x1;
         xResult -= x2;
         xResult -= curveA;
         xResult %= modulus;
 
-        yResult  = BigNum::mulMod(lamb, (x1 - xResult), modulus);
+        yResult  = BigNum::mulMod(lamb, (x1 - xResult), reducer);
         yResult -= y1;
         yResult %= modulus;
 
@@ -153,8 +155,8 @@ public:
     Point getPointGivenX(const BigNum &x)
     {
         Point point;
-        auto y_squared = BigNum::powMod(x, BigNum(3), modulus);
-        y_squared += BigNum::mulMod(curveA, BigNum::mulMod(x, x, modulus), modulus);
+        auto y_squared = BigNum::powMod(x, BigNum(3), reducer);
+        y_squared += BigNum::mulMod(curveA, BigNum::sqrMod(x, reducer), reducer);
         y_squared += x;
         y_squared %= modulus;
         if (BigNum::legendre(y_squared, modulus) != 1)
@@ -171,9 +173,9 @@ public:
     {
         const BigNum &y = point.y;
         const BigNum &x = point.x;
-        auto left_side = BigNum::mulMod(y, y, modulus);
-        auto right_side = BigNum::powMod(x, BigNum(3), modulus);
-        right_side += BigNum::mulMod(curveA, BigNum::mulMod(x, x, modulus), modulus);
+        auto left_side = BigNum::sqrMod(y, reducer);
+        auto right_side = BigNum::powMod(x, BigNum(3), reducer);
+        right_side += BigNum::mulMod(curveA, BigNum::sqrMod(x, reducer), reducer);
         right_side += x;
         right_side %= modulus;
         return (left_side == right_side);
@@ -182,5 +184,6 @@ public:
 private:
     BigNum modulus;
     BigNum curveA;
+    Reducer reducer;
 };
 
@@ -1,4 +1,10 @@
 #include <QtCore>
+#include <algorithm>
+#include <array>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 #pragma once
 
@@ -13,1765 +19,5523 @@
 #endif
 #endif
 
+#ifndef USEADXASM
+#define USEADXASM (1)
+#endif
+
+#ifdef __x86_64__
+#if (defined(__GNUC__) || defined(__clang__)) && USEADXASM
+#define HAS_ADXASM 1 // mulx/adcx/adox kernels, only run when the CPU reports BMI2 and ADX
+#endif
+#endif
+
+#ifndef QBIGNUM_ALIGNMENT
+#define QBIGNUM_ALIGNMENT (16)
+#endif
+
+#ifndef QBIGNUM_KARATSUBA_THRESHOLD
+#define QBIGNUM_KARATSUBA_THRESHOLD (24) // In words, operands at least this long use Karatsuba
+#endif
+
+#ifndef QBIGNUM_TOOM3_THRESHOLD
+#define QBIGNUM_TOOM3_THRESHOLD (192) // In words, operands at least this long use Toom-3
+#endif
+
+#ifndef QBIGNUM_NTT_THRESHOLD
+#define QBIGNUM_NTT_THRESHOLD (65536) // In words, operands at least this long use the NTT
+#endif
+
+#ifndef QBIGNUM_HGCD_THRESHOLD
+#define QBIGNUM_HGCD_THRESHOLD (1024) // In words, gcd operands at least this long use the half gcd
+#endif
+
+#ifndef QBIGNUM_HGCD_INVERSE_THRESHOLD
+#define QBIGNUM_HGCD_INVERSE_THRESHOLD (384) // In words, inverseMod by an odd modulus this long uses the half gcd
+#endif
+
+#ifndef QBIGNUM_MONTGOMERY_THRESHOLD
+#define QBIGNUM_MONTGOMERY_THRESHOLD (8) // Exponent bits from which powMod by an odd modulus works in Montgomery form
+#endif
+
+#ifndef QBIGNUM_UNROLL_WORDS
+#define QBIGNUM_UNROLL_WORDS (16) // Add, sub, compare and shift are fully unrolled up to this many words
+#endif
+
 #define NUM_WORDS(bits) (((bits) + 63) / 64)
 
-template <size_t Bits>
-class QBigNum
+/* Low level kernels working on little endian arrays of 64 bit limbs. They know nothing about signs
+   unless the comment says two's complement */
+namespace QBigNumKernels
 {
-private:
-    QList<uint64_t> data;
-
-    template <size_t ABits, size_t BBits>
-    static void copy(const QBigNum<ABits>& from, QBigNum<BBits>& to)
+    // r[0..n) += a[0..n) * b, returns the carry out limb
+    inline uint64_t addMul1Portable(uint64_t* r, const uint64_t* a, int n, uint64_t b)
     {
-        size_t minWords = qMin(NUM_WORDS(ABits), NUM_WORDS(BBits));
-        for (size_t i = 0; i < minWords; ++i)
-        {
-            to[i] = from[i];
-        }
-        if (from.isNegative())
+        uint64_t carry = 0;
+        for (int i = 0; i < n; ++i)
         {
-            for (size_t i = minWords; i < NUM_WORDS(BBits); ++i)
-            {
-                to[i] = ~0ULL;
-            }
+            __uint128_t product = (__uint128_t)a[i] * b + r[i] + carry;
+            r[i] = static_cast<uint64_t>(product);
+            carry = product >> 64;
         }
+        return carry;
+    }
 
-        if (to.isNegative() != from.isNegative())
+    // r[0..n) = a[0..n) * b + c, r may be a, returns the carry out limb
+    inline uint64_t mul1Portable(uint64_t* r, const uint64_t* a, int n, uint64_t b, uint64_t c = 0)
+    {
+        uint64_t carry = c;
+        for (int i = 0; i < n; ++i)
         {
-            throw std::overflow_error("Copy overflow");
+            __uint128_t product = (__uint128_t)a[i] * b + carry;
+            r[i] = static_cast<uint64_t>(product);
+            carry = product >> 64;
         }
+        return carry;
     }
 
-protected:
-public:
-    static constexpr int NUM_BITS = Bits;
-    static constexpr int NUM_WORDS = NUM_WORDS(Bits);
+#if defined(HAS_ADXASM)
+    /* Checked once at static initialisation so one binary runs on CPUs with and without ADX */
+    inline const bool cpuHasAdx = __builtin_cpu_supports("bmi2") && __builtin_cpu_supports("adx");
 
-    QBigNum()
+    /* addMul1 with two carry chains. adox adds the previous high word and adcx adds r[i], mulx leaves
+       the flags alone. The loop does two words a pass and counts a negative index up to zero with lea and
+       jrcxz, which keep CF and OF intact. The array operands tell the compiler which memory the loop reads
+       and writes, so the block needs neither volatile nor a memory clobber */
+    inline uint64_t addMul1Adx(uint64_t* r, const uint64_t* a, int n, uint64_t b)
     {
-        data.fill(0, NUM_WORDS);
+        uint64_t carry = 0;
+        if (n & 1)
+        {
+            __uint128_t product = (__uint128_t)a[0] * b + r[0];
+            r[0] = static_cast<uint64_t>(product);
+            carry = product >> 64;
+            ++r;
+            ++a;
+            --n;
+        }
+        if (n == 0)
+        {
+            return carry;
+        }
+
+        int64_t index = -static_cast<int64_t>(n);
+        uint64_t low, high, zero;
+        __asm__(
+            "xor %k[zero], %k[zero]\n\t" // Clears CF and OF
+            "1:\n\t"
+            "mulx (%[a],%[index],8), %[low], %[high]\n\t"
+            "adox %[carry], %[low]\n\t"
+            "adcx (%[r],%[index],8), %[low]\n\t"
+            "mov %[low], (%[r],%[index],8)\n\t"
+            "mulx 8(%[a],%[index],8), %[low], %[carry]\n\t"
+            "adox %[high], %[low]\n\t"
+            "adcx 8(%[r],%[index],8), %[low]\n\t"
+            "mov %[low], 8(%[r],%[index],8)\n\t"
+            "lea 2(%[index]), %[index]\n\t"
+            "jrcxz 2f\n\t"
+            "jmp 1b\n\t"
+            "2:\n\t"
+            "adox %[zero], %[carry]\n\t"
+            "adcx %[zero], %[carry]\n\t"
+            : [index] "+c"(index), [carry] "+r"(carry), [low] "=&r"(low), [high] "=&r"(high), [zero] "=&r"(zero),
+              "+m"(*reinterpret_cast<uint64_t(*)[]>(r))
+            : [a] "r"(a + n), [r] "r"(r + n), "d"(b), "m"(*reinterpret_cast<const uint64_t(*)[]>(a))
+            : "cc");
+        return carry;
     }
 
-    QBigNum(int64_t scalar)
+    /* mul1 on one adcx chain, mulx keeps the carry flag alive across the multiply. Needs n > 0 */
+    inline uint64_t mul1Adx(uint64_t* r, const uint64_t* a, int n, uint64_t b, uint64_t c)
     {
-        data.fill(0, NUM_WORDS);
-        data[0] = std::abs(scalar);
+        int64_t index = -static_cast<int64_t>(n);
+        uint64_t low, high;
+        __asm__(
+            "test %[index], %[index]\n\t" // Clears CF
+            "1:\n\t"
+            "mulx (%[a],%[index],8), %[low], %[high]\n\t"
+            "adcx %[carry], %[low]\n\t"
+            "mov %[low], (%[r],%[index],8)\n\t"
+            "mov %[high], %[carry]\n\t"
+            "lea 1(%[index]), %[index]\n\t"
+            "jrcxz 2f\n\t"
+            "jmp 1b\n\t"
+            "2:\n\t"
+            "adcx %[index], %[carry]\n\t" // index is zero here
+            : [index] "+c"(index), [carry] "+r"(c), [low] "=&r"(low), [high] "=&r"(high),
+              "+m"(*reinterpret_cast<uint64_t(*)[]>(r))
+            : [a] "r"(a + n), [r] "r"(r + n), "d"(b), "m"(*reinterpret_cast<const uint64_t(*)[]>(a))
+            : "cc");
+        return c;
+    }
+#endif
 
-        if (scalar < 0)
+    // r[0..n) += a[0..n) * b, returns the carry out limb
+    inline uint64_t addMul1(uint64_t* r, const uint64_t* a, int n, uint64_t b)
+    {
+#if defined(HAS_ADXASM)
+        if (cpuHasAdx)
         {
-            *this = -*this;
+            return addMul1Adx(r, a, n, b);
         }
+#endif
+        return addMul1Portable(r, a, n, b);
     }
 
-    QBigNum(const QString& number)
+    // r[0..n) = a[0..n) * b + c, r may be a, returns the carry out limb
+    inline uint64_t mul1(uint64_t* r, const uint64_t* a, int n, uint64_t b, uint64_t c = 0)
     {
-        if (number.trimmed().toUpper().startsWith("0X") ||
-            number.trimmed().toUpper().startsWith("-0X"))
+#if defined(HAS_ADXASM)
+        if (cpuHasAdx && n > 0)
         {
-            *this = fromHex(number);
+            return mul1Adx(r, a, n, b, c);
         }
-        else
+#endif
+        return mul1Portable(r, a, n, b, c);
+    }
+
+    // r[0..n) -= a[0..n) * b, returns the borrow out limb
+    inline uint64_t subMul1(uint64_t* r, const uint64_t* a, int n, uint64_t b)
+    {
+        uint64_t borrow = 0;
+        for (int i = 0; i < n; ++i)
         {
-            *this = fromDecimal(number);
+            __uint128_t product = (__uint128_t)a[i] * b + borrow;
+            uint64_t low = static_cast<uint64_t>(product);
+            borrow = product >> 64;
+#if defined(HAS_ADCINTRIN)
+            borrow += _subborrow_u64(0, r[i], low, (unsigned long long*)&r[i]);
+#else
+            borrow += (r[i] < low) ? 1 : 0;
+            r[i] -= low;
+#endif
         }
+        return borrow;
     }
 
-    /* Assignment */
-
-    QBigNum& operator=(int64_t scalar)
+    // Number of limbs of a[0..n) once the high zero limbs are dropped
+    inline int normalizedSize(const uint64_t* a, int n)
     {
-        *this = QBigNum(scalar);
-        return *this;
+        while (n > 0 && a[n - 1] == 0)
+        {
+            --n;
+        }
+        return n;
     }
 
-    QBigNum& operator=(const QString& number)
+    // r[0..n) = -r[0..n) in two's complement
+    inline void negate(uint64_t* r, int n)
     {
-        *this = QBigNum(number);
-        return *this;
+        uint64_t carry = 1;
+        for (int i = 0; i < n; ++i)
+        {
+            r[i] = ~r[i] + carry;
+            carry = (carry && r[i] == 0) ? 1 : 0;
+        }
     }
 
-    /* Shift operations */
-
-    QBigNum& operator<<=(int bits)
+    // r[0..n) = a[0..n) + b[0..n), returns the carry out
+    inline uint64_t add(uint64_t* r, const uint64_t* a, const uint64_t* b, int n)
     {
-        if (bits == 0)
+#if defined(HAS_ADCINTRIN)
+        uint8_t carry = 0;
+        for (int i = 0; i < n; ++i)
         {
-            return *this;
+            carry = _addcarry_u64(carry, a[i], b[i], (unsigned long long*)&r[i]);
         }
-
-        // Handle shifting full words first
-        int shift_words = bits / 64;
-        int bit_shift = bits % 64;
-
-        if (shift_words > 0)
+        return carry;
+#else
+        uint64_t carry = 0;
+        for (int i = 0; i < n; ++i)
         {
-            for (int i = NUM_WORDS - 1; i >= shift_words; --i)
-            {
-                data[i] = data[i - shift_words];
-            }
-            for (int i = 0; i < shift_words; ++i)
-            {
-                data[i] = 0; // Clear low words
-            }
+            __uint128_t sum = (__uint128_t)a[i] + b[i] + carry;
+            r[i] = static_cast<uint64_t>(sum);
+            carry = sum >> 64;
         }
+        return carry;
+#endif
+    }
 
-        if (bit_shift > 0)
+    // r[0..n) = a[0..n) - b[0..n), returns the borrow out
+    inline uint64_t sub(uint64_t* r, const uint64_t* a, const uint64_t* b, int n)
+    {
+#if defined(HAS_ADCINTRIN)
+        uint8_t borrow = 0;
+        for (int i = 0; i < n; ++i)
         {
-            for (int i = NUM_WORDS - 1; i > 0; --i)
-            {
-                data[i] = (data[i] << bit_shift) | (data[i - 1] >> (64 - bit_shift));
-            }
-            data[0] <<= bit_shift;
+            borrow = _subborrow_u64(borrow, a[i], b[i], (unsigned long long*)&r[i]);
         }
-
-        return *this;
+        return borrow;
+#else
+        uint64_t borrow = 0;
+        for (int i = 0; i < n; ++i)
+        {
+            uint64_t diff = a[i] - b[i] - borrow;
+            borrow = (a[i] < b[i] || (a[i] == b[i] && borrow)) ? 1 : 0;
+            r[i] = diff;
+        }
+        return borrow;
+#endif
     }
 
-    QBigNum& operator>>=(int bits)
+    // r[0..rn) += a[0..an) for an <= rn, returns the carry out
+    inline uint64_t addTo(uint64_t* r, int rn, const uint64_t* a, int an)
     {
-        if (bits == 0)
+        uint64_t carry = add(r, r, a, an);
+        for (int i = an; i < rn && carry; ++i)
         {
-            return *this;
+            carry = (++r[i] == 0) ? 1 : 0;
         }
+        return carry;
+    }
 
-        // Handle shifting full words first
-        int shift_words = bits / 64;
-        int bit_shift = bits % 64;
-
-        if (shift_words > 0)
+    // r[0..rn) -= a[0..an) for an <= rn, returns the borrow out
+    inline uint64_t subFrom(uint64_t* r, int rn, const uint64_t* a, int an)
+    {
+        uint64_t borrow = sub(r, r, a, an);
+        for (int i = an; i < rn && borrow; ++i)
         {
-            for (int i = 0; i < NUM_WORDS - shift_words; ++i)
-            {
-                data[i] = data[i + shift_words];
-            }
-            for (int i = NUM_WORDS - shift_words; i < NUM_WORDS; ++i)
-            {
-                data[i] = 0; // Clear high words
-            }
+            borrow = (r[i]-- == 0) ? 1 : 0;
         }
+        return borrow;
+    }
 
-        if (bit_shift > 0)
+    // Compares a[0..n) with b[0..n), returns -1, 0 or 1
+    inline int compare(const uint64_t* a, const uint64_t* b, int n)
+    {
+        for (int i = n - 1; i >= 0; --i)
         {
-            for (int i = 0; i < NUM_WORDS - 1; ++i)
+            if (a[i] != b[i])
             {
-                data[i] = (data[i] >> bit_shift) | (data[i + 1] << (64 - bit_shift));
+                return (a[i] > b[i]) ? 1 : -1;
             }
-            data[NUM_WORDS - 1] >>= bit_shift;
         }
-
-        return *this;
+        return 0;
     }
 
-    /* Scaler operations */
-    QBigNum& operator*=(int64_t scalar)
+    // r[0..n) = |a[0..n) - b[0..n)|, r may be a or b, returns true when a < b
+    inline bool subAbs(uint64_t* r, const uint64_t* a, const uint64_t* b, int n)
     {
-        if (scalar < 0)
+        if (compare(a, b, n) < 0)
         {
-            scalar *= -1;
-            *this = -*this;
+            sub(r, b, a, n);
+            return true;
         }
-        __uint128_t carry = 0;  // Using __uint128_t to hold 128-bit intermediate results
+        sub(r, a, b, n);
+        return false;
+    }
 
-        // Loop through each word in the QBigNum
-        for (int i = 0; i < NUM_WORDS; ++i)
-        {
-            // Multiply the current word by the scalar and add any carry from the previous iteration
-            __uint128_t result = static_cast<__uint128_t>(data[i]) * scalar + carry;
+    /* Fixed width kernels for the QBigNum operators. Up to QBIGNUM_UNROLL_WORDS words the folds over an
+       integer_sequence expand to straight line carry chains, wider numbers use the same steps in a loop */
+
+    // r += a + carry for one word, returns the carry out
+    inline uint64_t addCarry(uint64_t& r, uint64_t a, uint64_t carry)
+    {
+#if defined(HAS_ADCINTRIN)
+        return _addcarry_u64(static_cast<uint8_t>(carry), r, a, (unsigned long long*)&r);
+#else
+        __uint128_t sum = (__uint128_t)r + a + carry;
+        r = static_cast<uint64_t>(sum);
+        return static_cast<uint64_t>(sum >> 64);
+#endif
+    }
+
+    // r -= a + borrow for one word, returns the borrow out
+    inline uint64_t subBorrow(uint64_t& r, uint64_t a, uint64_t borrow)
+    {
+#if defined(HAS_ADCINTRIN)
+        return _subborrow_u64(static_cast<uint8_t>(borrow), r, a, (unsigned long long*)&r);
+#else
+        __uint128_t diff = (__uint128_t)r - a - borrow;
+        r = static_cast<uint64_t>(diff);
+        return static_cast<uint64_t>(diff >> 64) & 1;
+#endif
+    }
 
-            // Store the lower 64 bits of the result in the current word
-            data[i] = static_cast<uint64_t>(result);
+    // Word i of r[0..n), zero outside it
+    constexpr uint64_t wordOrZero(const uint64_t* r, int n, int i)
+    {
+        return (i >= 0 && i < n) ? r[i] : 0;
+    }
 
-            // Calculate the carry for the next word (higher 64 bits)
-            carry = result >> 64;  // The carry is the upper 64 bits of the 128-bit result
-        }
-        return *this;
+    // Word i of r[0..n) << (64 words + bits), bits in 0..63
+    constexpr uint64_t shiftedLeftWord(const uint64_t* r, int n, int i, int words, int bits)
+    {
+        uint64_t high = wordOrZero(r, n, i - words) << bits;
+        return (bits == 0) ? high : high | (wordOrZero(r, n, i - words - 1) >> (64 - bits));
     }
 
-    QBigNum& operator+=(int64_t scalar)
+    // Word i of r[0..n) >> (64 words + bits), bits in 0..63
+    constexpr uint64_t shiftedRightWord(const uint64_t* r, int n, int i, int words, int bits)
     {
-        if (scalar == 0)
+        uint64_t low = wordOrZero(r, n, i + words) >> bits;
+        return (bits == 0) ? low : low | (wordOrZero(r, n, i + words + 1) << (64 - bits));
+    }
+
+    template <int N, int... I>
+    inline uint64_t addFixedUnrolled(uint64_t* r, const uint64_t* a, std::integer_sequence<int, I...>)
+    {
+        uint64_t carry = 0;
+        ((carry = addCarry(r[I], a[I], carry)), ...);
+        return carry;
+    }
+
+    template <int N, int... I>
+    inline uint64_t subFixedUnrolled(uint64_t* r, const uint64_t* a, std::integer_sequence<int, I...>)
+    {
+        uint64_t borrow = 0;
+        ((borrow = subBorrow(r[I], a[I], borrow)), ...);
+        return borrow;
+    }
+
+    template <int N, int... I>
+    constexpr int compareFixedUnrolled(const uint64_t* a, const uint64_t* b, std::integer_sequence<int, I...>)
+    {
+        int result = 0;
+        ((result = (result != 0) ? result : (a[N - 1 - I] > b[N - 1 - I]) - (a[N - 1 - I] < b[N - 1 - I])), ...);
+        return result;
+    }
+
+    template <int N, int... I>
+    constexpr bool equalFixedUnrolled(const uint64_t* a, const uint64_t* b, std::integer_sequence<int, I...>)
+    {
+        return ((a[I] ^ b[I]) | ...) == 0;
+    }
+
+    /* Left shifts write from the top down and right shifts from the bottom up so every source word is read before it is overwritten */
+    template <int N, int... I>
+    constexpr void shiftLeftFixedUnrolled(uint64_t* r, int words, int bits, std::integer_sequence<int, I...>)
+    {
+        ((r[N - 1 - I] = shiftedLeftWord(r, N, N - 1 - I, words, bits)), ...);
+    }
+
+    template <int N, int... I>
+    constexpr void shiftRightFixedUnrolled(uint64_t* r, int words, int bits, std::integer_sequence<int, I...>)
+    {
+        ((r[I] = shiftedRightWord(r, N, I, words, bits)), ...);
+    }
+
+    template <int N, int... I>
+    constexpr void mul1FixedUnrolled(uint64_t* r, uint64_t b, std::integer_sequence<int, I...>)
+    {
+        __uint128_t carry = 0;
+        ((carry = (__uint128_t)r[I] * b + (carry >> 64), r[I] = static_cast<uint64_t>(carry)), ...);
+    }
+
+    // r[0..N) += a[0..N), returns the carry out
+    template <int N>
+    inline uint64_t addFixed(uint64_t* r, const uint64_t* a)
+    {
+        if constexpr (N <= QBIGNUM_UNROLL_WORDS)
         {
-            return *this; // No change for zero
+            return addFixedUnrolled<N>(r, a, std::make_integer_sequence<int, N>{});
         }
-
-        // Handle negative scalar
-        if (scalar < 0)
+        uint64_t carry = 0;
+        for (int i = 0; i < N; ++i)
         {
-            // Convert scalar to positive for subtraction
-            uint64_t absScalar = static_cast<uint64_t>(-scalar);
-            return *this -= absScalar; // Use subtraction for negative numbers
+            carry = addCarry(r[i], a[i], carry);
         }
+        return carry;
+    }
 
-        // Handle positive scalar
-#if defined(HAS_ADCINTRIN)
-        uint64_t carry = _addcarry_u64(0, data[0], scalar, (unsigned long long*)&data[0]);
-        for (int i = 1; i < NUM_WORDS; ++i)
+    // r[0..N) -= a[0..N), returns the borrow out
+    template <int N>
+    inline uint64_t subFixed(uint64_t* r, const uint64_t* a)
+    {
+        if constexpr (N <= QBIGNUM_UNROLL_WORDS)
         {
-            carry = _addcarry_u64(carry, data[i], 0, (unsigned long long*)&data[i]);
+            return subFixedUnrolled<N>(r, a, std::make_integer_sequence<int, N>{});
         }
-#else
-        uint64_t carry = static_cast<uint64_t>(scalar);
-
-        for (int i = 0; i < NUM_WORDS && carry != 0; ++i)
+        uint64_t borrow = 0;
+        for (int i = 0; i < N; ++i)
         {
-            // Add carry to the current word and compute the new carry
-            uint64_t sum = static_cast<uint64_t>(data[i]) + carry;
-            data[i] = static_cast<uint64_t>(sum);
-            carry = (sum < carry) ? 1 : 0; // Carry occurs if overflow happened
+            borrow = subBorrow(r[i], a[i], borrow);
         }
-#endif
-        return *this;
+        return borrow;
     }
 
-    QBigNum& operator-=(int64_t scalar)
+    // Compares a[0..N) with b[0..N) as unsigned numbers, returns -1, 0 or 1
+    template <int N>
+    constexpr int compareFixed(const uint64_t* a, const uint64_t* b)
     {
-        if (scalar == 0)
+        if constexpr (N <= QBIGNUM_UNROLL_WORDS)
         {
-            return *this; // No operation needed for zero
+            return compareFixedUnrolled<N>(a, b, std::make_integer_sequence<int, N>{});
         }
-
-        if (scalar < 0)
+        for (int i = N - 1; i >= 0; --i)
         {
-            // Subtracting a negative is equivalent to addition
-            *this += static_cast<uint64_t>(-scalar);
-            return *this;
+            if (a[i] != b[i])
+            {
+                return (a[i] > b[i]) ? 1 : -1;
+            }
         }
+        return 0;
+    }
 
-#if defined(HAS_ADCINTRIN)
-        uint64_t borrow = _subborrow_u64(0, data[0], scalar, (unsigned long long*)&data[0]);
-        for (int i = 1; i < NUM_WORDS; ++i)
+    template <int N>
+    constexpr bool equalFixed(const uint64_t* a, const uint64_t* b)
+    {
+        if constexpr (N <= QBIGNUM_UNROLL_WORDS)
         {
-            borrow = _subborrow_u64(borrow, data[i], 0, (unsigned long long*)&data[i]);
+            return equalFixedUnrolled<N>(a, b, std::make_integer_sequence<int, N>{});
         }
-#else
-        uint64_t borrow = static_cast<uint64_t>(scalar);
-        for (int i = 0; i < NUM_WORDS; ++i)
+        for (int i = 0; i < N; ++i)
         {
-            uint64_t current = static_cast<uint64_t>(data[i]);
-            uint64_t diff = current - borrow;
-            data[i] = static_cast<uint64_t>(diff);
-            borrow = (current < borrow) ? 1 : 0;
+            if (a[i] != b[i])
+            {
+                return false;
+            }
         }
-#endif
-
-        return *this;
+        return true;
     }
 
-    /* QBigNum operations */
-
-    QPair<QBigNum, QBigNum> operator/(const QBigNum& divisor) const
+    // r[0..N) <<= bits, bits past the top shift out
+    template <int N>
+    constexpr void shiftLeftFixed(uint64_t* r, int bits)
     {
-        QBigNum q;
-        QBigNum r = *this;
-        QBigNum d = divisor;
-
-        bool nflag = false;
-        if (isNegative())
+        int words = bits / 64;
+        bits %= 64;
+        if constexpr (N <= QBIGNUM_UNROLL_WORDS)
         {
-            nflag = !nflag;
-            r = -r;
+            shiftLeftFixedUnrolled<N>(r, words, bits, std::make_integer_sequence<int, N>{});
+            return;
         }
-        if (d.isNegative())
+        for (int i = N - 1; i >= 0; --i)
         {
-            nflag = !nflag;
-            d = -d;
+            r[i] = shiftedLeftWord(r, N, i, words, bits);
         }
+    }
 
-        /* Find first words that aren't zero or just use the zeroth word */
-        int kr, kd;
-        for (kd = NUM_WORDS - 1; kd > 0 && d.data[kd] == 0; --kd)
+    // r[0..N) >>= bits without sign extension
+    template <int N>
+    constexpr void shiftRightFixed(uint64_t* r, int bits)
+    {
+        int words = bits / 64;
+        bits %= 64;
+        if constexpr (N <= QBIGNUM_UNROLL_WORDS)
         {
-            //
+            shiftRightFixedUnrolled<N>(r, words, bits, std::make_integer_sequence<int, N>{});
+            return;
         }
-        for (kr = NUM_WORDS - 1; kr > 0 && r.data[kr] == 0; --kr)
+        for (int i = 0; i < N; ++i)
         {
-            //
+            r[i] = shiftedRightWord(r, N, i, words, bits);
         }
+    }
 
-        if (kd == 0 && d.data[kd] == 0)
+    // r[0..N) *= b mod 2^(64N)
+    template <int N>
+    constexpr void mul1Fixed(uint64_t* r, uint64_t b)
+    {
+        if constexpr (N <= QBIGNUM_UNROLL_WORDS)
         {
-            throw std::overflow_error("Division by zero");
+            mul1FixedUnrolled<N>(r, b, std::make_integer_sequence<int, N>{});
+            return;
         }
-
-        /* Calculate shift that divisor would like to maximize number of bits in chunk_divisor but dont want to make
-         * it -ve */
-        __uint128_t chunk_divisor = (__uint128_t)d.data[kd] + 1;
-        int shift = (chunk_divisor < (__uint128_t)0xFFFFFFFFFFFFFFFFULL) ? __builtin_clzll(chunk_divisor) : 0;
-        if (kd == NUM_WORDS - 1)
+        __uint128_t carry = 0;
+        for (int i = 0; i < N; ++i)
         {
-            shift--;
+            carry = (__uint128_t)r[i] * b + (carry >> 64);
+            r[i] = static_cast<uint64_t>(carry);
         }
+    }
 
-        /* If that shift is too big for the numerator then reduce the shift such that the numerator wont overflow.
-         * the +1 is for the sign bit as we dont want to turn a +ve number into a -ve number */
-        int r_length = (r.bitLength() + shift + 1);
-        if (r_length > (int)Bits)
+    // r[0..an+bn) = a[0..an) * b[0..bn), r must not overlap a or b
+    inline void mulSchoolbook(uint64_t* r, const uint64_t* a, int an, const uint64_t* b, int bn)
+    {
+        if (an == 0 || bn == 0)
+        {
+            std::fill(r, r + an + bn, 0);
+            return;
+        }
+        r[an] = mul1(r, a, an, b[0]);
+        for (int j = 1; j < bn; ++j)
         {
-            shift = shift - (r_length - (int)Bits);
+            r[an + j] = addMul1(r + j, a, an, b[j]);
         }
+    }
 
-        /* Normalize */
-        r <<= shift;
-        d <<= shift;
+    // r[0..2n) = a[0..n)^2, each cross product is computed once and doubled, r must not overlap a
+    inline void sqrSchoolbook(uint64_t* r, const uint64_t* a, int n)
+    {
+        std::fill(r, r + 2 * n, 0);
 
-        chunk_divisor = (__uint128_t)d.data[kd] + 1;
+        // Cross products a[i] * a[j] for i < j
+        for (int i = 0; i < n - 1; ++i)
+        {
+            r[i + n] = addMul1(r + 2 * i + 1, a + i + 1, n - i - 1, a[i]);
+        }
 
-        /* kr might have gone up by one word during the shift */
-        for (kr = qMin(kr + 1, NUM_WORDS - 1); kr > 0 && r.data[kr] == 0; --kr)
+        // Double them
+        uint64_t top = 0;
+        for (int k = 0; k < 2 * n; ++k)
         {
-            //
+            uint64_t word = r[k];
+            r[k] = (word << 1) | top;
+            top = word >> 63;
         }
 
-        /* Long division */
-        while(true)
+        // Add the squares on the diagonal
+        uint64_t carry = 0;
+        for (int i = 0; i < n; ++i)
         {
-            __uint128_t chunk_dividend = 0;
-            QBigNum subnumber;
+            __uint128_t square = (__uint128_t)a[i] * a[i];
+            __uint128_t low = (__uint128_t)r[2 * i] + static_cast<uint64_t>(square) + carry;
+            r[2 * i] = static_cast<uint64_t>(low);
+            __uint128_t high = (__uint128_t)r[2 * i + 1] + static_cast<uint64_t>(square >> 64) + (uint64_t)(low >> 64);
+            r[2 * i + 1] = static_cast<uint64_t>(high);
+            carry = high >> 64;
+        }
+    }
 
-            /* Find the first word of remainder */
-            for (; kr > 0 && r.data[kr] == 0; --kr)
+    // r[0..n) = a[0..an) * b[0..bn) mod 2^(64n), r must not overlap a or b
+    inline void mulLow(uint64_t* r, int n, const uint64_t* a, int an, const uint64_t* b, int bn)
+    {
+        std::fill(r, r + n, 0);
+        for (int j = 0; j < bn && j < n; ++j)
+        {
+            int len = qMin(an, n - j);
+            uint64_t carry = addMul1(r + j, a, len, b[j]);
+            if (j + len < n)
             {
-                //
+                r[j + len] = carry;
             }
-            for (int k = kr; k >= kd; --k)
-            {
-                chunk_dividend |= r.data[k];
-                if (chunk_dividend < chunk_divisor)
-                {
-                    chunk_dividend <<= 64;
-                    continue;
-                }
+        }
+    }
 
-                uint64_t temp_result = chunk_dividend / chunk_divisor;
-                subnumber <<= 64;
-                subnumber |= temp_result;
-                chunk_dividend -= temp_result * chunk_divisor;
-                chunk_dividend <<= 64;
-            }
+    /* Division by invariant integers, Moller and Granlund 2011. With a reciprocal worked out once per
+       divisor each quotient word costs a couple of multiplies instead of a 128 bit division */
 
-            if (subnumber == 0)
+    // floor((2^128 - 1) / d) - 2^64 for d with its top bit set
+    inline uint64_t reciprocal2by1(uint64_t d)
+    {
+        return static_cast<uint64_t>((((__uint128_t)~d) << 64 | ~0ULL) / d);
+    }
+
+    // Reciprocal of the two word divisor (d1, d0) with the top bit of d1 set
+    inline uint64_t reciprocal3by2(uint64_t d1, uint64_t d0)
+    {
+        uint64_t v = reciprocal2by1(d1);
+        uint64_t p = d1 * v + d0;
+        if (p < d0)
+        {
+            --v;
+            if (p >= d1)
             {
-                if (r >= d)
-                {
-                    q++;
-                    r -= d;
-                }
-                break;
+                --v;
+                p -= d1;
             }
-
-            r -= (subnumber * d);
-            q += subnumber;
+            p -= d1;
         }
-
-        /* Denormalize */
-        r >>= shift;
-
-        if (nflag)
+        __uint128_t t = (__uint128_t)v * d0;
+        uint64_t t1 = static_cast<uint64_t>(t >> 64);
+        uint64_t t0 = static_cast<uint64_t>(t);
+        p += t1;
+        if (p < t1)
         {
-            q = -q;
+            --v;
+            if (p > d1 || (p == d1 && t0 >= d0))
+            {
+                --v;
+            }
         }
+        return v;
+    }
 
-        /* Sign of r is dictated by divisor */
-        if (divisor.isNegative())
+    // (u1, u0) / d for u1 < d with the top bit of d set, remainder into r
+    inline uint64_t divRem2by1(uint64_t u1, uint64_t u0, uint64_t d, uint64_t v, uint64_t& r)
+    {
+        __uint128_t q = (__uint128_t)v * u1 + (((__uint128_t)u1 << 64) | u0);
+        uint64_t q1 = static_cast<uint64_t>(q >> 64) + 1;
+        uint64_t q0 = static_cast<uint64_t>(q);
+        r = u0 - q1 * d;
+        if (r > q0)
         {
-            r = -r;
+            --q1;
+            r += d;
         }
-
-        /* If signs don't match and there is a remainder */
-        if (divisor.isNegative() != isNegative() && r != 0)
+        if (r >= d)
         {
-            q--;
-            r = divisor - r;
+            ++q1;
+            r -= d;
         }
-
-        /* should be r = dividend - q * divisor */
-
-        return QPair<QBigNum, QBigNum>(q, r);
+        return q1;
     }
 
-    QPair<QBigNum, QBigNum> operator/(int64_t scalar) const
+    // (u2, u1, u0) / (d1, d0) for (u2, u1) < (d1, d0) with the top bit of d1 set, remainder into r
+    inline uint64_t divRem3by2(uint64_t u2, uint64_t u1, uint64_t u0, uint64_t d1, uint64_t d0, uint64_t v, __uint128_t& r)
     {
-        QBigNum divisor(scalar);
-        return (*this / divisor);
+        __uint128_t q = (__uint128_t)v * u2 + (((__uint128_t)u2 << 64) | u1);
+        uint64_t q1 = static_cast<uint64_t>(q >> 64);
+        uint64_t q0 = static_cast<uint64_t>(q);
+        __uint128_t d = ((__uint128_t)d1 << 64) | d0;
+        uint64_t r1 = u1 - q1 * d1;
+        r = ((((__uint128_t)r1 << 64) | u0) - (__uint128_t)d0 * q1) - d;
+        ++q1;
+        if (static_cast<uint64_t>(r >> 64) >= q0)
+        {
+            --q1;
+            r += d;
+        }
+        if (r >= d)
+        {
+            ++q1;
+            r -= d;
+        }
+        return q1;
     }
 
-    QBigNum div(const QBigNum& divisor) const
+    // q[0..an) = a[0..an) / d, returns the remainder
+    inline uint64_t divRem1(uint64_t* q, const uint64_t* a, int an, uint64_t d)
     {
-        auto [quotient, remainder] = *this / divisor;
-        return quotient;
+        /* Normalise d and feed the numerator through shifted on the fly */
+        int shift = __builtin_clzll(d);
+        d <<= shift;
+        uint64_t v = reciprocal2by1(d);
+        uint64_t remainder = (shift == 0 || an == 0) ? 0 : a[an - 1] >> (64 - shift);
+        for (int i = an - 1; i >= 0; --i)
+        {
+            uint64_t word = a[i] << shift;
+            if (shift > 0 && i > 0)
+            {
+                word |= a[i - 1] >> (64 - shift);
+            }
+            q[i] = divRem2by1(remainder, word, d, v, remainder);
+        }
+        return remainder >> shift;
     }
 
-    QBigNum div(int64_t divisor) const
+    // a[0..an) mod d, divRem1 without storing the quotient
+    inline uint64_t mod1(const uint64_t* a, int an, uint64_t d)
     {
-        return this->div(QBigNum(divisor));
+        int shift = __builtin_clzll(d);
+        d <<= shift;
+        uint64_t v = reciprocal2by1(d);
+        uint64_t remainder = (shift == 0 || an == 0) ? 0 : a[an - 1] >> (64 - shift);
+        for (int i = an - 1; i >= 0; --i)
+        {
+            uint64_t word = a[i] << shift;
+            if (shift > 0 && i > 0)
+            {
+                word |= a[i - 1] >> (64 - shift);
+            }
+            divRem2by1(remainder, word, d, v, remainder);
+        }
+        return remainder >> shift;
     }
 
-    static QBigNum div(QBigNum dividend, QBigNum divisor)
+    // Words of scratch space divRem needs
+    constexpr int divRemScratchSize(int an, int dn)
     {
-        auto [quotient, remainder] = dividend / divisor;
-        return quotient;
+        return an + 1 + dn;
     }
 
-    static QBigNum div(const QString& dividend, const QString& divisor)
+    /* Knuth's Algorithm D. q[0..an-dn+1) = a / d and r[0..dn) = a mod d for an >= dn and d[dn-1] != 0.
+       Each quotient word is the 3 by 2 quotient of the top three words of the remainder by the top two
+       words of d, which is at most one too big, then taken off in one subMul1 pass.
+       q may be null when only the remainder is wanted, r may alias a */
+    inline void divRem(uint64_t* q, uint64_t* r, const uint64_t* a, int an, const uint64_t* d, int dn, uint64_t* scratch)
     {
-        auto [quotient, remainder] = QBigNum(dividend) / QBigNum(divisor);
-        return quotient;
-    }
+        if (dn == 1)
+        {
+            r[0] = (q != nullptr) ? divRem1(q, a, an, d[0]) : mod1(a, an, d[0]);
+            return;
+        }
 
-    QBigNum& operator|=(uint64_t scalar)
-    {
-        data[0] |= scalar;
-        return *this;
+        /* Normalise so the top bit of d is set, u gets an extra top word for the bits shifted out */
+        int shift = __builtin_clzll(d[dn - 1]);
+        uint64_t* u = scratch;
+        uint64_t* v = u + an + 1;
+        std::copy(a, a + an, u);
+        u[an] = 0;
+        std::copy(d, d + dn, v);
+        if (shift > 0)
+        {
+            u[an] = a[an - 1] >> (64 - shift);
+            for (int i = an - 1; i > 0; --i)
+            {
+                u[i] = (u[i] << shift) | (u[i - 1] >> (64 - shift));
+            }
+            u[0] <<= shift;
+            for (int i = dn - 1; i > 0; --i)
+            {
+                v[i] = (v[i] << shift) | (v[i - 1] >> (64 - shift));
+            }
+            v[0] <<= shift;
+        }
+
+        uint64_t v1 = v[dn - 1];
+        uint64_t v2 = v[dn - 2];
+        uint64_t reciprocal = reciprocal3by2(v1, v2);
+        for (int j = an - dn; j >= 0; --j)
+        {
+            uint64_t u0 = u[j + dn];
+            uint64_t u1 = u[j + dn - 1];
+            uint64_t u2 = u[j + dn - 2];
+            uint64_t qhat;
+            if (u0 == v1 && u1 == v2)
+            {
+                /* Top of the remainder equals the top of v, the quotient word saturates */
+                qhat = ~0ULL;
+            }
+            else
+            {
+                __uint128_t rhat;
+                qhat = divRem3by2(u0, u1, u2, v1, v2, reciprocal, rhat);
+            }
+
+            uint64_t borrow = subMul1(u + j, v, dn, qhat);
+            if (u0 < borrow)
+            {
+                /* Rare, qhat was still one too big */
+                --qhat;
+                add(u + j, u + j, v, dn);
+            }
+            u[j + dn] = 0;
+            if (q != nullptr)
+            {
+                q[j] = qhat;
+            }
+        }
+
+        /* Remainder is the low dn words of u, denormalised */
+        if (shift > 0)
+        {
+            for (int i = 0; i < dn - 1; ++i)
+            {
+                r[i] = (u[i] >> shift) | (u[i + 1] << (64 - shift));
+            }
+            r[dn - 1] = u[dn - 1] >> shift;
+        }
+        else
+        {
+            std::copy(u, u + dn, r);
+        }
     }
 
-    QBigNum& operator&=(uint64_t scalar)
+    // r[0..dn) = a mod d, divRem without the quotient
+    inline void mod(uint64_t* r, const uint64_t* a, int an, const uint64_t* d, int dn, uint64_t* scratch)
     {
-        data[0] &= scalar;
-        return *this;
+        divRem(nullptr, r, a, an, d, dn, scratch);
     }
 
-    static QBigNum abs(const QBigNum& num)
+    // r[0..n) = t[0..2n) / 2^(64n) mod m[0..n) for t < m 2^(64n) and mInv = -m^-1 mod 2^64, clobbers t
+    inline void montgomeryReduce(uint64_t* r, uint64_t* t, const uint64_t* m, int n, uint64_t mInv)
     {
-        QBigNum result = num;
-        if (result.isNegative())
+        /* Each step zeroes t[i], so park its carry there and add them all in at the end */
+        for (int i = 0; i < n; ++i)
         {
-            return -result;
+            uint64_t q = t[i] * mInv;
+            t[i] = addMul1(t + i, m, n, q);
+        }
+        uint64_t carry = add(r, t + n, t, n);
+        if (carry || compare(r, m, n) >= 0)
+        {
+            sub(r, r, m, n);
         }
-        return result;
     }
 
-    static QBigNum abs(const QString& num)
+    /* r[0..n) = a b / 2^(64n) mod m for a, b < m by CIOS, each word of b is multiplied in and reduced away
+       straight after so the running sum never grows past n + 2 words. t needs 2n + 1 words, the window onto
+       it slides up a word a step instead of shifting. r may alias a or b */
+    inline void montgomeryMul(uint64_t* r, const uint64_t* a, const uint64_t* b, const uint64_t* m, int n, uint64_t mInv, uint64_t* t)
     {
-        return QBigNum::abs(QBigNum(num));
-    }
+        std::fill(t, t + 2 * n + 1, 0);
+        for (int i = 0; i < n; ++i)
+        {
+            uint64_t* w = t + i;
+            uint64_t carry = addMul1(w, a, n, b[i]);
+            w[n] += carry;
+            w[n + 1] = (w[n] < carry) ? 1 : 0;
 
-    static QBigNum legendre(const QBigNum& a, const QBigNum& p)
-    {
-        return QBigNum::powMod(a, (p - 1).div(2), p);
+            uint64_t q = w[0] * mInv;
+            carry = addMul1(w, m, n, q);
+            w[n] += carry;
+            w[n + 1] += (w[n] < carry) ? 1 : 0;
+        }
+        if (t[2 * n] || compare(t + n, m, n) >= 0)
+        {
+            sub(r, t + n, m, n);
+        }
+        else
+        {
+            std::copy(t + n, t + 2 * n, r);
+        }
     }
 
-    static QBigNum legendre(const QString& a, const QString& p)
+    // Number of trailing zero bits of a[0..n), which must not be zero
+    inline int trailingZeros(const uint64_t* a, int n)
     {
-        return QBigNum::legendre(QBigNum(a), QBigNum(p));
+        int i = 0;
+        while (i < n - 1 && a[i] == 0)
+        {
+            ++i;
+        }
+        return 64 * i + __builtin_ctzll(a[i]);
     }
 
-    static QBigNum legendre(int64_t a, int64_t p)
+    // Divsteps per outer round of gcdOdd, the cofactors stay within 2^62
+    constexpr int GCD_STEPS = 62;
+
+    // r[0..n] = |a f + b g| / 2^GCD_STEPS for a[0..n), b[0..n), the division is exact. r may be b.
+    // Returns true if a f + b g < 0
+    inline bool gcdCombine(uint64_t* r, const uint64_t* a, const uint64_t* b, int n, int64_t f, int64_t g)
     {
-        return QBigNum::legendre(QBigNum(a), QBigNum(p));
+        /* |a_i f + b_i g| < 2^127, so a signed 128 bit accumulator holds each column and its carry */
+        __int128 carry = 0;
+        for (int i = 0; i < n; ++i)
+        {
+            __int128 column = __int128(a[i]) * f + __int128(b[i]) * g + carry;
+            r[i] = uint64_t(column);
+            carry = column >> 64;
+        }
+        r[n] = uint64_t(carry);
+        bool negative = carry < 0;
+        if (negative)
+        {
+            negate(r, n + 1);
+        }
+        for (int i = 0; i < n; ++i)
+        {
+            r[i] = (r[i] >> GCD_STEPS) | (r[i + 1] << (64 - GCD_STEPS));
+        }
+        r[n] >>= GCD_STEPS;
+        return negative;
     }
 
-    /* prime number test */
-    static bool millerRabin(const QBigNum& n, int k = 44)
+    // Runs GCD_STEPS subtract and halve steps for a[0..n) and b[0..n), b odd, and returns the matrix
+    // [f0 g0; f1 g1] taking (a, b) to 2^GCD_STEPS times the next pair. Pornin's optimised binary gcd: the steps
+    // run on a two word stand in made of the low 62 and the top 64 bits of each number, which gets the same
+    // low bit decisions and nearly always the same comparisons
+    inline void gcdSteps(const uint64_t* a, const uint64_t* b, int n, int64_t& f0, int64_t& g0, int64_t& f1, int64_t& g1)
     {
-        if (n <= 1)
+        constexpr unsigned __int128 lowMask = (unsigned __int128)(uint64_t(1) << GCD_STEPS) - 1;
+
+        /* Below 2 GCD_STEPS + 2 bits the stand ins are the numbers themselves */
+        int bits = 64 * (n - 1) + 64 - __builtin_clzll(a[n - 1] | b[n - 1]);
+        unsigned __int128 x;
+        unsigned __int128 y;
+        if (bits <= 2 * GCD_STEPS + 2)
         {
-            return false;
+            x = a[0] | (unsigned __int128)wordOrZero(a, n, 1) << 64;
+            y = b[0] | (unsigned __int128)wordOrZero(b, n, 1) << 64;
         }
-        if (n == 2 || n == 3)
+        else
         {
-            return true; // n is prime
+            int shift = bits - 64;
+            x = (a[0] & lowMask) | (unsigned __int128)shiftedRightWord(a, n, 0, shift / 64, shift % 64) << GCD_STEPS;
+            y = (b[0] & lowMask) | (unsigned __int128)shiftedRightWord(b, n, 0, shift / 64, shift % 64) << GCD_STEPS;
         }
-        if (n % 2 == 0)
+
+        /* x = (f0 a + g0 b) / 2^i and y = (f1 a + g1 b) / 2^i approximately, y stays odd */
+        f0 = 1;
+        g0 = 0;
+        f1 = 0;
+        g1 = 1;
+        int i = 0;
+        while (i < GCD_STEPS)
         {
-            return false; // Even numbers > 2 are not prime
+            if (x & 1)
+            {
+                if (x < y)
+                {
+                    std::swap(x, y);
+                    std::swap(f0, f1);
+                    std::swap(g0, g1);
+                }
+                x -= y;
+                f0 -= f1;
+                g0 -= g1;
+            }
+            int zeros = (uint64_t(x) != 0) ? __builtin_ctzll(uint64_t(x)) : (x != 0) ? 64 + __builtin_ctzll(uint64_t(x >> 64)) : GCD_STEPS;
+            zeros = qMin(zeros, GCD_STEPS - i);
+            x >>= zeros;
+            f1 *= int64_t(1) << zeros;
+            g1 *= int64_t(1) << zeros;
+            i += zeros;
         }
+    }
 
-        // Small prime divisors check
-        std::vector<int> smallPrimes = {5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47, 53, 59, 61, 67, 71, 73, 79, 83, 89, 97};
-        for (int prime : smallPrimes)
+    // gcd(a, b) for b odd, left in b[0..n) with its size returned. a, b and the scratch t need n + 1 words.
+    // Each round the gcdSteps matrix is applied to the full numbers in one pass
+    inline int gcdOdd(uint64_t* a, uint64_t* b, int n, uint64_t* t)
+    {
+        for (;;)
         {
-            QBigNum primeBN = QBigNum(prime);
-            if (n % primeBN == 0 && n != primeBN)
+            int an = normalizedSize(a, n);
+            int bn = normalizedSize(b, n);
+            if (an == 0)
             {
-                return false;
+                return bn;
             }
+            n = qMax(an, bn);
+
+            int64_t f0, g0, f1, g1;
+            gcdSteps(a, b, n, f0, g0, f1, g1);
+            gcdCombine(t, a, b, n, f0, g0);
+            gcdCombine(b, a, b, n, f1, g1);
+            std::copy(t, t + n + 1, a);
+            ++n;
         }
+    }
 
-        // Write n - 1 as d * 2^r
-        QBigNum d = n - 1;
-        int r = 0;
-        while (d % 2 == 0)
+    // r[0..n) = (u f + v g) / 2^GCD_STEPS mod m for u[0..n), v[0..n) in [0, m), m odd and mInv = -m^-1 mod 2^64.
+    // r needs n + 1 words and may be v
+    inline void gcdCombineMod(uint64_t* r, const uint64_t* u, const uint64_t* v, const uint64_t* m, int n, int64_t f, int64_t g, uint64_t mInv)
+    {
+        /* Adding k m clears the low GCD_STEPS bits so the division is exact, as in a Montgomery reduction */
+        int64_t k = int64_t(((u[0] * uint64_t(f) + v[0] * uint64_t(g)) * mInv) & ((uint64_t(1) << GCD_STEPS) - 1));
+        __int128 carry = 0;
+        for (int i = 0; i < n; ++i)
         {
-            d /= 2;
-            r++;
+            __int128 column = __int128(u[i]) * f + __int128(v[i]) * g + __int128(m[i]) * k + carry;
+            r[i] = uint64_t(column);
+            carry = column >> 64;
         }
-
-        // Perform k iterations of the test
-        for (int i = 0; i < k; ++i)
+        r[n] = uint64_t(carry);
+        for (int i = 0; i < n; ++i)
         {
-            // Generate random a in range [2, n - 2]
-            QBigNum a = QBigNum::randomInRange(2, n - 2);
+            r[i] = (r[i] >> GCD_STEPS) | (r[i + 1] << (64 - GCD_STEPS));
+        }
+        r[n] = uint64_t(int64_t(r[n]) >> GCD_STEPS);
 
-            // Compute x = a^d % n
-            QBigNum x = QBigNum::powMod(a, d, n);
+        /* |u f + v g| < m 2^GCD_STEPS and k m < m 2^GCD_STEPS leave the quotient in (-m, 2m) */
+        if (int64_t(r[n]) < 0)
+        {
+            addTo(r, n + 1, m, n);
+        }
+        else if (r[n] != 0 || compare(r, m, n) >= 0)
+        {
+            subFrom(r, n + 1, m, n);
+        }
+    }
 
-            if (x == 1 || x == n - 1)
+    // Runs the gcdOdd rounds on a[0..n] and the odd b[0..n] while keeping x u == a and x r == b mod m, m odd
+    // of n words and mInv = -m^-1 mod 2^64. Returns true when b ends at 1, r is then x^-1 mod m. u and r are
+    // in [0, m) with n + 1 words of room, the scratch s needs n + 1 words
+    inline bool gcdOddCofactors(uint64_t* a, uint64_t* b, uint64_t* u, uint64_t* r, const uint64_t* m, int n, uint64_t mInv, uint64_t* s)
+    {
+        int size = n;
+        for (;;)
+        {
+            int an = normalizedSize(a, size);
+            int bn = normalizedSize(b, size);
+            if (an == 0)
             {
-                continue;
+                return bn == 1 && b[0] == 1;
             }
+            size = qMax(an, bn);
 
-            bool isComposite = true;
-            for (int j = 0; j < r - 1; ++j)
+            int64_t f0, g0, f1, g1;
+            gcdSteps(a, b, size, f0, g0, f1, g1);
+            if (gcdCombine(s, a, b, size, f0, g0))
             {
-                x = QBigNum::mulMod(x, x, n);
-                if (x == n - 1)
-                {
-                    isComposite = false;
-                    break;
-                }
+                f0 = -f0;
+                g0 = -g0;
             }
-
-            if (isComposite)
+            if (gcdCombine(b, a, b, size, f1, g1))
             {
-                return false;
+                f1 = -f1;
+                g1 = -g1;
             }
-        }
+            std::copy(s, s + size + 1, a);
+            ++size;
 
-        return true; // n is probably prime
+            gcdCombineMod(s, u, r, m, n, f0, g0, mInv);
+            gcdCombineMod(r, u, r, m, n, f1, g1, mInv);
+            std::copy(s, s + n, u);
+        }
     }
 
-    static bool millerRabin(const QString& n, int k = 44)
+    // r[0..n) = x^-1 mod m for x[0..n) < m[0..n) and m odd, returns false when gcd(x, m) != 1.
+    // r needs n + 1 words and the scratch t 4 (n + 1)
+    inline bool inverseOdd(uint64_t* r, const uint64_t* x, const uint64_t* m, int n, uint64_t* t)
     {
-        return QBigNum::millerRabin(QBigNum(n), k);
+        uint64_t* a = t;
+        uint64_t* b = t + (n + 1);
+        uint64_t* u = t + 2 * (n + 1);
+        std::copy(x, x + n, a);
+        std::copy(m, m + n, b);
+        std::fill(u, u + n + 1, 0);
+        std::fill(r, r + n + 1, 0);
+        a[n] = 0;
+        b[n] = 0;
+        u[0] = 1;
+
+        uint64_t inverse = m[0];
+        for (int i = 0; i < 5; ++i)
+        {
+            inverse *= 2 - m[0] * inverse;
+        }
+        return gcdOddCofactors(a, b, u, r, m, n, 0 - inverse, t + 3 * (n + 1));
     }
 
-    static bool millerRabin(int64_t n, int k = 44)
+    // Runs GCD_STEPS posdivsteps on the low words f and g of two non negative numbers, f odd, and returns the
+    // matrix [u v; q r] taking them to 2^GCD_STEPS times the next pair. These are Bernstein-Yang divsteps with
+    // g + w f in place of g - f, as in libsecp256k1's Jacobi symbol, so neither number goes negative and each sign
+    // change of (g/f) can be read off the low bits. Bit 0 of jac is toggled for each one
+    inline int64_t jacobiSteps(int64_t eta, uint64_t f, uint64_t g, uint64_t& u, uint64_t& v, uint64_t& q, uint64_t& r, int& jac)
     {
-        return QBigNum::millerRabin(QBigNum(n), k);
+        u = 1;
+        v = 0;
+        q = 0;
+        r = 1;
+        int i = GCD_STEPS;
+        for (;;)
+        {
+            /* (2/f) is -1 for f = 3 or 5 mod 8 */
+            int zeros = __builtin_ctzll(g | (~uint64_t(0) << i));
+            g >>= zeros;
+            u <<= zeros;
+            v <<= zeros;
+            eta -= zeros;
+            i -= zeros;
+            jac ^= zeros & int((f >> 1) ^ (f >> 2)) & 1;
+            if (i == 0)
+            {
+                break;
+            }
+
+            /* w = -g / f mod 2^limit clears the low bits of g + w f, six at most after a swap and four otherwise */
+            uint64_t w;
+            int limit;
+            if (eta < 0)
+            {
+                /* Quadratic reciprocity flips the sign when both are 3 mod 4 */
+                eta = -eta;
+                std::swap(f, g);
+                std::swap(u, q);
+                std::swap(v, r);
+                jac ^= int((f & g) >> 1) & 1;
+                limit = int(qMin<int64_t>(eta + 1, i));
+                w = (f * g * (f * f - 2)) & (~uint64_t(0) >> (64 - limit)) & 63;
+            }
+            else
+            {
+                limit = int(qMin<int64_t>(eta + 1, i));
+                w = f + (((f + 1) & 4) << 1);
+                w = (0 - w * g) & (~uint64_t(0) >> (64 - limit)) & 15;
+            }
+            g += f * w;
+            q += u * w;
+            r += v * w;
+        }
+        return eta;
     }
 
-    /* generalization of legendre but for compisitte numbers so no use for tonelli */
-    static int jacobi(const QBigNum& a, const QBigNum& n)
+    // Jacobi symbol (g/f) for f[0..n) odd and g[0..n), both overwritten and given n + 1 words like the scratch t.
+    // Each round applies the jacobiSteps matrix to the full numbers, whose entries sum to at most 2^GCD_STEPS so
+    // nothing grows. Random inputs take about 3 posdivsteps per bit but convergence is not proven, so past 4 per bit
+    // one exact binary step runs at a time instead
+    inline int jacobiOdd(uint64_t* f, uint64_t* g, int n, uint64_t* t)
     {
-        QBigNum aCopy = a % n;
-        QBigNum nCopy = n;
+        int64_t eta = -1;
+        int jac = 0;
+        int rounds = 4 * 64 * n / GCD_STEPS + 4;
+        for (;;)
+        {
+            /* Posdivsteps need not take g to 0, they settle at f = 1 for coprime inputs and usually at f = g
+               otherwise */
+            int fn = normalizedSize(f, n);
+            int gn = normalizedSize(g, n);
+            if (fn == 1 && f[0] == 1)
+            {
+                return 1 - 2 * jac;
+            }
+            if (gn == 0 || (fn == gn && compare(f, g, fn) == 0))
+            {
+                return 0;
+            }
+            n = qMax(fn, gn);
+            if (rounds-- == 0)
+            {
+                break;
+            }
+
+            uint64_t u, v, q, r;
+            eta = jacobiSteps(eta, f[0], g[0], u, v, q, r, jac);
+            gcdCombine(t, f, g, n, int64_t(u), int64_t(v));
+            gcdCombine(g, f, g, n, int64_t(q), int64_t(r));
+            std::copy(t, t + n, f);
+        }
 
-        // Handle base cases
-        if (aCopy == 0)
+        for (;;)
         {
-            return 0; // Jacobi symbol (0/n) = 0
+            int gn = normalizedSize(g, n);
+            if (gn == 0)
+            {
+                return (normalizedSize(f, n) == 1 && f[0] == 1) ? 1 - 2 * jac : 0;
+            }
+            int zeros = trailingZeros(g, gn);
+            for (int i = 0; i < gn; ++i)
+            {
+                g[i] = shiftedRightWord(g, gn, i, zeros / 64, zeros % 64);
+            }
+            jac ^= zeros & int((f[0] >> 1) ^ (f[0] >> 2)) & 1;
+            if (compare(g, f, n) < 0)
+            {
+                std::swap_ranges(f, f + n, g);
+                jac ^= int((f[0] & g[0]) >> 1) & 1;
+            }
+            sub(g, g, f, n);
         }
-        if (aCopy == 1)
+    }
+
+    // r[0..n) <<= 1, returns the bit shifted out
+    inline uint64_t shiftLeft1(uint64_t* r, int n)
+    {
+        uint64_t carry = 0;
+        for (int i = 0; i < n; ++i)
         {
-            return 1; // Jacobi symbol (1/n) = 1
+            uint64_t next = r[i] >> 63;
+            r[i] = (r[i] << 1) | carry;
+            carry = next;
         }
+        return carry;
+    }
 
-        int result = 1;
+    // r[0..n) >>= 1 keeping the sign of a two's complement number
+    inline void shiftRightSigned1(uint64_t* r, int n)
+    {
+        for (int i = 0; i < n - 1; ++i)
+        {
+            r[i] = (r[i] >> 1) | (r[i + 1] << 63);
+        }
+        r[n - 1] = static_cast<uint64_t>(static_cast<int64_t>(r[n - 1]) >> 1);
+    }
 
-        // When a is negative, make it positive and flip the sign of result
-        if (aCopy < 0)
+    // r[0..n) /= 3 for an exact multiple of 3, two's complement values work too
+    inline void divExact3(uint64_t* r, int n)
+    {
+        constexpr uint64_t inverse3 = 0xAAAAAAAAAAAAAAABULL; // 3 * inverse3 == 1 mod 2^64
+        uint64_t borrow = 0;
+        for (int i = 0; i < n; ++i)
         {
-            aCopy = -aCopy;
-            if (nCopy % 4 == 3)
-            {
-                result = -result; // Flip sign if n mod 4 is 3
-            }
+            uint64_t x = r[i] - borrow;
+            uint64_t under = (r[i] < borrow) ? 1 : 0;
+            uint64_t q = x * inverse3;
+            r[i] = q;
+            borrow = static_cast<uint64_t>(((__uint128_t)q * 3) >> 64) + under;
         }
+    }
+
+    // Operand lengths in words at which the balanced multiply switches algorithm
+    struct MulThresholds
+    {
+        int karatsuba;
+        int toom3;
+        int ntt = std::numeric_limits<int>::max();
+    };
+
+    // Words of scratch space mulBalanced and sqrBalanced need for n word operands, whatever the thresholds
+    constexpr int balancedScratchSize(int n)
+    {
+        return (n <= 1) ? 0 : qMax(6 * (n - n / 2) + 1 + balancedScratchSize(n - n / 2),
+                                   (n < 5) ? 0 : 12 * ((n + 2) / 3 + 1) + balancedScratchSize((n + 2) / 3 + 1));
+    }
+
+    // Words of scratch space mul needs for operands of up to n words
+    constexpr int mulScratchSize(int n)
+    {
+        return 8 * n + balancedScratchSize(n);
+    }
 
-        // Apply the law of quadratic reciprocity
-        while (aCopy != 0)
+    /* Number theoretic transform multiplication. Each product coefficient is below n 2^128, so three primes
+       just under 2^64 recover it exactly with the CRT */
+    namespace Ntt
+    {
+        constexpr int maxLog = 50; // Every prime has 2^50 | p - 1, plenty for any transform length
+
+        constexpr uint64_t powMod(uint64_t b, uint64_t e, uint64_t p)
         {
-            while (aCopy % 2 == 0)
+            uint64_t result = 1;
+            while (e)
             {
-                aCopy = aCopy.div(2);
-                if (nCopy % 8 == 3 || nCopy % 8 == 5)
+                if (e & 1)
                 {
-                    result = -result; // Flip sign when n mod 8 is 3 or 5
+                    result = static_cast<uint64_t>((__uint128_t)result * b % p);
                 }
+                b = static_cast<uint64_t>((__uint128_t)b * b % p);
+                e >>= 1;
             }
+            return result;
+        }
 
-            // Swap a and n if n > a
-            if (n > a)
+        // p^-1 mod 2^64 for odd p by Newton iteration, each step doubles the correct bits
+        constexpr uint64_t inverse64(uint64_t p)
+        {
+            uint64_t x = p;
+            for (int i = 0; i < 5; ++i)
             {
-                QBigNum tmp = aCopy;
-                aCopy = nCopy;
-                nCopy = tmp;
+                x *= 2 - p * x;
             }
+            return x;
+        }
+
+        /* p = c 2^50 + 1 above 2^63, values are kept in Montgomery form x 2^64 mod p */
+        struct Prime
+        {
+            uint64_t p;
+            uint64_t pInv;  // p^-1 mod 2^64
+            uint64_t one;   // 2^64 mod p
+            uint64_t r2;    // 2^128 mod p
+            uint64_t root;  // Primitive 2^maxLog th root of unity, Montgomery form
 
-            if (aCopy % 4 == 3 && nCopy % 4 == 3)
+            constexpr Prime(uint64_t prime, uint64_t generator)
+                : p(prime),
+                  pInv(inverse64(prime)),
+                  one(0 - prime),
+                  r2(static_cast<uint64_t>((__uint128_t)(0 - prime) * (0 - prime) % prime)),
+                  root(static_cast<uint64_t>((__uint128_t)powMod(generator, (prime - 1) >> maxLog, prime) * (0 - prime) % prime))
             {
-                result = -result; // Apply quadratic reciprocity
             }
 
-            aCopy = aCopy % nCopy;
-        }
+            // Montgomery form of a plain value below p
+            constexpr uint64_t toMontgomery(uint64_t x) const
+            {
+                return static_cast<uint64_t>((__uint128_t)x * one % p);
+            }
+        };
 
-        // If a is 1, return 1, otherwise return the result
-        return (nCopy == 1) ? result : 0;
-    }
+        constexpr Prime primes[3] = {Prime(0xffd8000000000001ULL, 7), Prime(0xffd0000000000001ULL, 3), Prime(0xffb4000000000001ULL, 13)};
 
-    /* p needs to be prime for this algo wil find quadratic residuals */
-    static QBigNum tonelli(const QBigNum& n, const QBigNum& p)
-    {
-        if (n == 1 || n == 0)
+        // a b 2^-64 mod p, works for any a, b < p even though p > 2^63
+        inline uint64_t mulMod(uint64_t a, uint64_t b, const Prime& prime)
         {
-            return n;
+            __uint128_t t = (__uint128_t)a * b;
+            uint64_t m = static_cast<uint64_t>(t) * prime.pInv;
+            uint64_t mpHigh = static_cast<uint64_t>(((__uint128_t)m * prime.p) >> 64);
+            uint64_t tHigh = static_cast<uint64_t>(t >> 64);
+            uint64_t result = tHigh - mpHigh;
+            return (tHigh < mpHigh) ? result + prime.p : result;
         }
 
-        if (legendre(n, p) != 1)
+        // Branch free, the butterflies are too random to predict
+        inline uint64_t addMod(uint64_t a, uint64_t b, const Prime& prime)
         {
-            throw std::invalid_argument("Not a square (mod p)");
+            uint64_t sum = a + b;
+            uint64_t reduced = sum - prime.p;
+            bool keep = (sum >= a) & (sum < prime.p);
+            return keep ? sum : reduced;
         }
 
-        static QBigNum p_last;
-        static bool p_last_is_prime = false;
-
-        if (p != p_last)
+        inline uint64_t subMod(uint64_t a, uint64_t b, const Prime& prime)
         {
-            p_last = p;
-            p_last_is_prime = QBigNum::millerRabin(p_last);
+            uint64_t diff = a - b;
+            return diff + (prime.p & (0 - static_cast<uint64_t>(a < b)));
         }
 
-        if (!p_last_is_prime)
+        /* Twiddles for every butterfly length, table[len + j] = w^j for a primitive 2 len th root w, Montgomery form.
+           The entries for one length don't depend on the transform size, so each thread keeps a table per prime and
+           only rebuilds it when a longer transform comes along */
+        inline const std::vector<uint64_t>& twiddles(int logSize, int index)
         {
-            throw std::invalid_argument("p isn't prime");
-        }
-
-        QBigNum q = p - 1;
-        uint s = 0;
-
-        // Factorize p - 1 as q * 2^s
-        while ((q % 2) == 0)
-        {
-            q /= 2;
-            s++;
+            thread_local std::vector<uint64_t> tables[3];
+            std::vector<uint64_t>& table = tables[index];
+            size_t size = qMax(size_t(2), size_t(1) << logSize);
+            if (table.size() >= size)
+            {
+                return table;
+            }
+            const Prime& prime = primes[index];
+            table.assign(size, 0);
+            uint64_t w = prime.root;
+            for (int i = qMax(logSize, 1); i < maxLog; ++i)
+            {
+                w = mulMod(w, w, prime);
+            }
+            size_t half = size / 2;
+            table[half] = prime.one;
+            for (size_t j = 1; j < half; ++j)
+            {
+                table[half + j] = mulMod(table[half + j - 1], w, prime);
+            }
+            /* Shorter lengths use every other power of the next one up */
+            for (size_t len = half / 2; len >= 1; len /= 2)
+            {
+                for (size_t j = 0; j < len; ++j)
+                {
+                    table[len + j] = table[2 * len + 2 * j];
+                }
+            }
+            return table;
         }
 
-        if (s == 1)
+        /* Decimation in frequency, natural order in and bit reversed order out */
+        inline void forward(std::vector<uint64_t>& x, const std::vector<uint64_t>& table, Prime prime)
         {
-            return QBigNum::powMod(n, (p + 1).div(4), p);
+            size_t size = x.size();
+            uint64_t* data = x.data();
+            for (size_t len = size / 2; len >= 1; len /= 2)
+            {
+                const uint64_t* w = table.data() + len;
+                for (size_t start = 0; start < size; start += 2 * len)
+                {
+                    uint64_t* lo = data + start;
+                    uint64_t* hi = lo + len;
+                    for (size_t j = 0; j < len; ++j)
+                    {
+                        uint64_t u = lo[j];
+                        uint64_t v = hi[j];
+                        lo[j] = addMod(u, v, prime);
+                        hi[j] = mulMod(subMod(u, v, prime), w[j], prime);
+                    }
+                }
+            }
         }
 
-        // Find a non-residue z
-        QBigNum z = 2;
-        while (legendre(z, p) != p - 1)
+        /* Decimation in time with inverse twiddles, bit reversed order in and natural order times size out */
+        inline void inverse(std::vector<uint64_t>& x, const std::vector<uint64_t>& table, Prime prime)
         {
-            z++;
+            size_t size = x.size();
+            uint64_t* data = x.data();
+            for (size_t len = 1; len < size; len *= 2)
+            {
+                for (size_t start = 0; start < size; start += 2 * len)
+                {
+                    uint64_t* lo = data + start;
+                    uint64_t* hi = lo + len;
+                    /* w^-j = -w^(len - j), so -v w^-j = v w^(len - j) and the twiddle sign folds into the butterfly */
+                    uint64_t v = hi[0];
+                    uint64_t u = lo[0];
+                    lo[0] = addMod(u, v, prime);
+                    hi[0] = subMod(u, v, prime);
+                    for (size_t j = 1; j < len; ++j)
+                    {
+                        u = lo[j];
+                        v = mulMod(hi[j], table[2 * len - j], prime);
+                        lo[j] = subMod(u, v, prime);
+                        hi[j] = addMod(u, v, prime);
+                    }
+                }
+            }
         }
 
-        QBigNum c = QBigNum::powMod(z, q, p);
-        QBigNum r = QBigNum::powMod(n, (q + 1).div(2), p);
-        QBigNum t = QBigNum::powMod(n, q, p);
-        uint m = s;
-
-        while ((t - 1) % p != 0)
+        /* Cyclic convolution of a and b mod the prime at index into fa, result in plain form. b == nullptr squares a,
+           otherwise fb is the second transform buffer. Both keep their capacity between calls */
+        inline void convolve(std::vector<uint64_t>& fa, std::vector<uint64_t>& fb, const uint64_t* a, int an, const uint64_t* b, int bn, int logSize, int index)
         {
-            QBigNum t2 = t;
-            uint i = 0;
+            const Prime& prime = primes[index];
+            size_t size = size_t(1) << logSize;
+            const std::vector<uint64_t>& table = twiddles(logSize, index);
 
-            for (i = 1; i < m; ++i)
+            fa.assign(size, 0);
+            for (int i = 0; i < an; ++i)
             {
-                t2 = QBigNum::mulMod(t2, t2, p);
-                if ((t2 - 1) % p == 0)
+                fa[i] = (a[i] >= prime.p) ? a[i] - prime.p : a[i];
+            }
+            forward(fa, table, prime);
+
+            /* The pointwise products pick up a 2^-64, so they are scaled by 2^128 / size on the way, 1 / size is
+               p - (p - 1) / size */
+            uint64_t scale = mulMod(mulMod(prime.r2, prime.r2, prime), prime.p - ((prime.p - 1) >> logSize), prime);
+            if (b == nullptr)
+            {
+                for (size_t i = 0; i < size; ++i)
                 {
-                    break;
+                    fa[i] = mulMod(mulMod(fa[i], fa[i], prime), scale, prime);
                 }
             }
-
-            QBigNum b = QBigNum::powMod(c, QBigNum(1) << (m - i - 1), p);
-            r = QBigNum::mulMod(r, b, p);
-            c = QBigNum::mulMod(b, b, p);
-            t = QBigNum::mulMod(t, c, p);
-            m = i;
+            else
+            {
+                fb.assign(size, 0);
+                for (int i = 0; i < bn; ++i)
+                {
+                    fb[i] = (b[i] >= prime.p) ? b[i] - prime.p : b[i];
+                }
+                forward(fb, table, prime);
+                for (size_t i = 0; i < size; ++i)
+                {
+                    fa[i] = mulMod(mulMod(fa[i], fb[i], prime), scale, prime);
+                }
+            }
+            inverse(fa, table, prime);
         }
 
-        return r;
+        // Garner constants, Montgomery form so one mulMod multiplies by the plain value
+        constexpr uint64_t inv01 = primes[1].toMontgomery(powMod(primes[0].p % primes[1].p, primes[1].p - 2, primes[1].p));
+        constexpr uint64_t inv02 = primes[2].toMontgomery(powMod(primes[0].p % primes[2].p, primes[2].p - 2, primes[2].p));
+        constexpr uint64_t inv12 = primes[2].toMontgomery(powMod(primes[1].p % primes[2].p, primes[2].p - 2, primes[2].p));
+        constexpr __uint128_t p01 = (__uint128_t)primes[0].p * primes[1].p;
     }
 
-    static QBigNum tonelli(const QString& n, const QString& p)
+    // r[0..an+bn) = a[0..an) * b[0..bn) by NTT over three primes, a == b with an == bn squares
+    inline void mulNtt(uint64_t* r, const uint64_t* a, int an, const uint64_t* b, int bn)
     {
-        return QBigNum::tonelli(QBigNum(n), QBigNum(p));
+        using namespace Ntt;
+        int logSize = 0;
+        while ((1 << logSize) < an + bn - 1)
+        {
+            ++logSize;
+        }
+
+        /* Transform buffers are reused across calls, the allocations cost as much as a small transform */
+        thread_local std::vector<uint64_t> x0, x1, x2, fb;
+        const uint64_t* second = (a == b && an == bn) ? nullptr : b;
+        convolve(x0, fb, a, an, second, bn, logSize, 0);
+        convolve(x1, fb, a, an, second, bn, logSize, 1);
+        convolve(x2, fb, a, an, second, bn, logSize, 2);
+
+        int rn = an + bn;
+        std::fill(r, r + rn, 0);
+        for (int i = 0; i < rn - 1; ++i)
+        {
+            /* Garner: c = t0 + t1 p0 + t2 p0 p1 */
+            uint64_t t0 = x0[i];
+            uint64_t t1 = mulMod(subMod(x1[i], (t0 >= primes[1].p) ? t0 - primes[1].p : t0, primes[1]), inv01, primes[1]);
+            uint64_t t2 = mulMod(subMod(x2[i], (t0 >= primes[2].p) ? t0 - primes[2].p : t0, primes[2]), inv02, primes[2]);
+            t2 = mulMod(subMod(t2, (t1 >= primes[2].p) ? t1 - primes[2].p : t1, primes[2]), inv12, primes[2]);
+
+            __uint128_t low = (__uint128_t)t1 * primes[0].p + t0;
+            __uint128_t mid = (__uint128_t)t2 * static_cast<uint64_t>(p01);
+            __uint128_t high = (__uint128_t)t2 * static_cast<uint64_t>(p01 >> 64);
+            uint64_t c[3];
+            __uint128_t sum = (__uint128_t)static_cast<uint64_t>(low) + static_cast<uint64_t>(mid);
+            c[0] = static_cast<uint64_t>(sum);
+            sum = (sum >> 64) + (low >> 64) + (mid >> 64) + static_cast<uint64_t>(high);
+            c[1] = static_cast<uint64_t>(sum);
+            c[2] = static_cast<uint64_t>(sum >> 64) + static_cast<uint64_t>(high >> 64);
+
+            addTo(r + i, rn - i, c, qMin(3, rn - i));
+        }
     }
 
-    static QBigNum tonelli(int64_t n, int64_t p)
-    {
-        return QBigNum::tonelli(QBigNum(n), QBigNum(p));
-    }
+    inline void mulBalanced(uint64_t* r, const uint64_t* a, const uint64_t* b, int n, uint64_t* scratch, const MulThresholds& thresholds);
+    inline void sqrBalanced(uint64_t* r, const uint64_t* a, int n, uint64_t* scratch, const MulThresholds& thresholds);
 
-    /* Doesn't check for overflow */
-    QBigNum& operator*=(const QBigNum& other)
+    // r[0..2n) = a[0..n) * b[0..n) using (a0 - a1)(b1 - b0) + a0 b0 + a1 b1 for the middle term
+    inline void mulKaratsuba(uint64_t* r, const uint64_t* a, const uint64_t* b, int n, uint64_t* scratch, const MulThresholds& thresholds)
     {
-        QBigNum result;
-        // Multiply each word of *this by each word of other
-        for (size_t i = 0; i < NUM_WORDS; ++i)
+        int h = n / 2;
+        int hh = n - h;
+        const uint64_t* a0 = a;
+        const uint64_t* a1 = a + h;
+        const uint64_t* b0 = b;
+        const uint64_t* b1 = b + h;
+
+        /* Low and high products go straight into the result */
+        mulBalanced(r, a0, b0, h, scratch, thresholds);
+        mulBalanced(r + 2 * h, a1, b1, hh, scratch, thresholds);
+
+        uint64_t* da = scratch;
+        uint64_t* db = da + hh;
+        uint64_t* product = db + hh;
+        uint64_t* middle = product + 2 * hh;
+        uint64_t* next = middle + 2 * hh + 1;
+
+        /* |a0 - a1| and |b1 - b0| with the low halves padded to hh words */
+        std::copy(a0, a0 + h, da);
+        std::copy(b0, b0 + h, db);
+        if (hh > h)
+        {
+            da[h] = 0;
+            db[h] = 0;
+        }
+        bool negative = subAbs(da, da, a1, hh);
+        negative ^= subAbs(db, b1, db, hh);
+        mulBalanced(product, da, db, hh, next, thresholds);
+
+        /* middle = a0 b0 + a1 b1 +- product, which is a0 b1 + a1 b0 so never -ve */
+        std::copy(r + 2 * h, r + 2 * n, middle);
+        middle[2 * hh] = 0;
+        addTo(middle, 2 * hh + 1, r, 2 * h);
+        if (negative)
         {
-            __uint128_t carry = 0;
-            for (size_t j = 0; i + j < NUM_WORDS; ++j)
-            {
-                __uint128_t product = (__uint128_t)this->data[i] * other.data[j] + result.data[i + j] + carry;
-                result.data[i + j] = static_cast<uint64_t>(product);  // Store lower 64 bits
-                carry = product >> 64;  // Carry for next higher bits
-            }
+            subFrom(middle, 2 * hh + 1, product, 2 * hh);
         }
-        *this = result;
-        return *this;  // Return the modified object
+        else
+        {
+            addTo(middle, 2 * hh + 1, product, 2 * hh);
+        }
+
+        addTo(r + h, 2 * n - h, middle, 2 * hh + 1);
     }
 
-    QBigNum& operator-=(const QBigNum& other)
+    // r[0..2n) = a[0..n)^2 using a0^2 + a1^2 - (a0 - a1)^2 for the middle term
+    inline void sqrKaratsuba(uint64_t* r, const uint64_t* a, int n, uint64_t* scratch, const MulThresholds& thresholds)
     {
-#if defined(HAS_ADCINTRIN)
-        uint8_t borrow = 0;
-        for (int i = 0; i < NUM_WORDS; ++i)
-        {
-            borrow = _subborrow_u64(borrow, data[i], other.data[i], (unsigned long long*)&data[i]);
-        }
-#else
-        __uint128_t borrow = 0;
-        for (int i = 0; i < NUM_WORDS; ++i)
+        int h = n / 2;
+        int hh = n - h;
+        const uint64_t* a0 = a;
+        const uint64_t* a1 = a + h;
+
+        sqrBalanced(r, a0, h, scratch, thresholds);
+        sqrBalanced(r + 2 * h, a1, hh, scratch, thresholds);
+
+        uint64_t* da = scratch;
+        uint64_t* product = da + hh;
+        uint64_t* middle = product + 2 * hh;
+        uint64_t* next = middle + 2 * hh + 1;
+
+        std::copy(a0, a0 + h, da);
+        if (hh > h)
         {
-            uint64_t diff = data[i] - other.data[i] - borrow;
-            borrow = (data[i] < other.data[i] + borrow) ? 1 : 0;
-            data[i] = diff;
+            da[h] = 0;
         }
-#endif
-        return *this;
+        subAbs(da, da, a1, hh);
+        sqrBalanced(product, da, hh, next, thresholds);
+
+        std::copy(r + 2 * h, r + 2 * n, middle);
+        middle[2 * hh] = 0;
+        addTo(middle, 2 * hh + 1, r, 2 * h);
+        subFrom(middle, 2 * hh + 1, product, 2 * hh);
+
+        addTo(r + h, 2 * n - h, middle, 2 * hh + 1);
     }
 
-    QBigNum& operator+=(const QBigNum& other)
+    /* Toom-3 evaluation of a0 + a1 x + a2 x^2 at 1, -1 and -2 as w = k + 1 word two's complement numbers */
+    inline void toom3Evaluate(uint64_t* p1, uint64_t* pm1, uint64_t* pm2, const uint64_t* a, int k, int n2)
     {
-#if defined(HAS_ADCINTRIN)
-        uint8_t carry = 0;
-        for (int i = 0; i < NUM_WORDS; ++i)
-        {
-            carry = _addcarry_u64(carry, data[i], other.data[i], (unsigned long long*)&data[i]);
-        }
-#else
-        __int128_t carry = 0;
-        for (int i = 0; i < NUM_WORDS; ++i)
-        {
-            __uint128_t sum = (__int128_t)data[i] + (__int128_t)other.data[i] + carry;
-            data[i] = sum;
-            carry = sum >> 64;
-        }
-#endif
-        return *this;
+        int w = k + 1;
+        const uint64_t* a0 = a;
+        const uint64_t* a1 = a + k;
+        const uint64_t* a2 = a + 2 * k;
+
+        std::copy_n(a0, k, p1);
+        p1[k] = 0;
+        addTo(p1, w, a2, n2);
+
+        std::copy(p1, p1 + w, pm1);
+        subFrom(pm1, w, a1, k);
+        addTo(p1, w, a1, k);
+
+        /* p(-2) = 2 (p(-1) + a2) - a0 */
+        std::copy(pm1, pm1 + w, pm2);
+        addTo(pm2, w, a2, n2);
+        shiftLeft1(pm2, w);
+        subFrom(pm2, w, a0, k);
     }
 
-    QBigNum& operator++()
+    /* Adds the interpolated Toom-3 coefficients into r, r0 and rinf must already be in place with the gap between zeroed */
+    inline void toom3Interpolate(uint64_t* r, int n, int k, int n2, uint64_t* r1, uint64_t* rm1, uint64_t* rm2)
     {
-        for (int i = 0; i < NUM_WORDS; ++i)
-        {
-            if (++data[i] != 0)
-            {
-                break; // No carry needed
-            }
-        }
-        return *this;
+        int pw = 2 * k + 2;
+        const uint64_t* r0 = r;
+        const uint64_t* rinf = r + 4 * k;
+
+        /* Bodrato's sequence, all in pw word two's complement */
+        sub(rm2, rm2, r1, pw);
+        divExact3(rm2, pw);
+        sub(r1, r1, rm1, pw);
+        shiftRightSigned1(r1, pw);
+        subFrom(rm1, pw, r0, 2 * k);
+        sub(rm2, rm1, rm2, pw);
+        shiftRightSigned1(rm2, pw);
+        addTo(rm2, pw, rinf, 2 * n2);
+        addTo(rm2, pw, rinf, 2 * n2);
+        add(rm1, rm1, r1, pw);
+        subFrom(rm1, pw, rinf, 2 * n2);
+        sub(r1, r1, rm2, pw);
+
+        /* r1, rm1 and rm2 now hold the x, x^2 and x^3 coefficients, all non negative */
+        addTo(r + k, 2 * n - k, r1, qMin(pw, 2 * n - k));
+        addTo(r + 2 * k, 2 * n - 2 * k, rm1, qMin(pw, 2 * n - 2 * k));
+        addTo(r + 3 * k, 2 * n - 3 * k, rm2, qMin(pw, 2 * n - 3 * k));
     }
 
-    QBigNum& operator--()
+    /* r[0..2k+2) = a[0..k+1) * b[0..k+1) where the top words are small, the recursion only sees k words */
+    inline void mulTopWord(uint64_t* r, const uint64_t* a, const uint64_t* b, int k, uint64_t* scratch, const MulThresholds& thresholds)
     {
-        for (int i = 0; i < NUM_WORDS; ++i)
-        {
-            if (data[i]-- != 0)
-            {
-                break; // No borrow needed
-            }
-        }
-        return *this;
+        mulBalanced(r, a, b, k, scratch, thresholds);
+        r[2 * k] = addMul1(r + k, b, k, a[k]);
+        r[2 * k + 1] = 0;
+        uint64_t carry = addMul1(r + k, a, k, b[k]);
+        __uint128_t top = (__uint128_t)a[k] * b[k] + carry + r[2 * k];
+        r[2 * k] = static_cast<uint64_t>(top);
+        r[2 * k + 1] = static_cast<uint64_t>(top >> 64);
     }
 
-    static QBigNum mulMod(QBigNum a, QBigNum b, QBigNum m)
+    /* r[0..2k+2) = a[0..k+1)^2 where the top word is small */
+    inline void sqrTopWord(uint64_t* r, const uint64_t* a, int k, uint64_t* scratch, const MulThresholds& thresholds)
     {
-        QBigNum<(2*Bits)> resultData; // 1024-bit intermediate result
-        QBigNum<(2*Bits)> mbig;
-        QBigNum res;
+        sqrBalanced(r, a, k, scratch, thresholds);
+        r[2 * k] = 0;
+        r[2 * k + 1] = 0;
+        uint64_t carry = addMul1(r + k, a, k, a[k] << 1);
+        __uint128_t top = (__uint128_t)a[k] * a[k] + carry;
+        r[2 * k] = static_cast<uint64_t>(top);
+        r[2 * k + 1] = static_cast<uint64_t>(top >> 64);
+    }
 
-        bool negFlag = false;
-        if (a.isNegative())
+    /* r[0..2w) = a[0..w) * b[0..w) for two's complement operands with small top words, clobbers a and b */
+    inline void mulSigned(uint64_t* r, uint64_t* a, uint64_t* b, int w, uint64_t* scratch, const MulThresholds& thresholds)
+    {
+        bool negativeA = a[w - 1] >> 63;
+        bool negativeB = b[w - 1] >> 63;
+        if (negativeA)
         {
-            a = -a;
-            negFlag = !negFlag;
+            negate(a, w);
         }
-        if (b.isNegative())
+        if (negativeB)
         {
-            b = -b;
-            negFlag = !negFlag;
+            negate(b, w);
         }
-
-        // Multiply each word of *this by each word of other
-        for (size_t i = 0; i < NUM_WORDS; ++i)
+        mulTopWord(r, a, b, w - 1, scratch, thresholds);
+        if (negativeA != negativeB)
         {
-            __uint128_t carry = 0;
-            for (size_t j = 0; j < NUM_WORDS; ++j)
-            {
-                __uint128_t product = (__uint128_t)a[i] * b[j] + resultData[i + j] + carry;
-                resultData[i + j] = static_cast<uint64_t>(product);  // Store lower 64 bits
-                carry = product >> 64;  // Carry for next higher bits
-            }
-            resultData[i + NUM_WORDS] = static_cast<uint64_t>(carry);  // Store the last carry
+            negate(r, 2 * w);
         }
+    }
 
-        if (negFlag)
-        {
-            resultData = -resultData;
-        }
+    // r[0..2n) = a[0..n) * b[0..n) evaluating at 0, 1, -1, -2 and infinity, needs n >= 5
+    inline void mulToom3(uint64_t* r, const uint64_t* a, const uint64_t* b, int n, uint64_t* scratch, const MulThresholds& thresholds)
+    {
+        int k = (n + 2) / 3;
+        int n2 = n - 2 * k;
+        int w = k + 1;
+
+        uint64_t* pa1 = scratch;
+        uint64_t* pam1 = pa1 + w;
+        uint64_t* pam2 = pam1 + w;
+        uint64_t* pb1 = pam2 + w;
+        uint64_t* pbm1 = pb1 + w;
+        uint64_t* pbm2 = pbm1 + w;
+        uint64_t* r1 = pbm2 + w;
+        uint64_t* rm1 = r1 + 2 * w;
+        uint64_t* rm2 = rm1 + 2 * w;
+        uint64_t* next = rm2 + 2 * w;
+
+        toom3Evaluate(pa1, pam1, pam2, a, k, n2);
+        toom3Evaluate(pb1, pbm1, pbm2, b, k, n2);
+        mulTopWord(r1, pa1, pb1, k, next, thresholds);
+        mulSigned(rm1, pam1, pbm1, w, next, thresholds);
+        mulSigned(rm2, pam2, pbm2, w, next, thresholds);
+
+        mulBalanced(r, a, b, k, next, thresholds);
+        std::fill(r + 2 * k, r + 4 * k, 0);
+        mulBalanced(r + 4 * k, a + 2 * k, b + 2 * k, n2, next, thresholds);
+
+        toom3Interpolate(r, n, k, n2, r1, rm1, rm2);
+    }
 
-        uint bitCount = qMax(resultData.bitLength(), m.bitLength());
-        if (bitCount >= Bits)
+    // r[0..2n) = a[0..n)^2 evaluating at 0, 1, -1, -2 and infinity, needs n >= 5
+    inline void sqrToom3(uint64_t* r, const uint64_t* a, int n, uint64_t* scratch, const MulThresholds& thresholds)
+    {
+        int k = (n + 2) / 3;
+        int n2 = n - 2 * k;
+        int w = k + 1;
+
+        uint64_t* pa1 = scratch;
+        uint64_t* pam1 = pa1 + w;
+        uint64_t* pam2 = pam1 + w;
+        uint64_t* r1 = pam2 + w;
+        uint64_t* rm1 = r1 + 2 * w;
+        uint64_t* rm2 = rm1 + 2 * w;
+        uint64_t* next = rm2 + 2 * w;
+
+        toom3Evaluate(pa1, pam1, pam2, a, k, n2);
+        if (pam1[w - 1] >> 63)
         {
-            /* Do the mod operation in the bigger space */
-            copy(m, mbig);
-            resultData %= mbig;
-            copy(resultData, res);
+            negate(pam1, w);
         }
-        else
+        if (pam2[w - 1] >> 63)
         {
-            copy(resultData, res);
-            res %= m;
+            negate(pam2, w);
         }
+        sqrTopWord(r1, pa1, k, next, thresholds);
+        sqrTopWord(rm1, pam1, k, next, thresholds);
+        sqrTopWord(rm2, pam2, k, next, thresholds);
 
-        return res;
-    }
+        sqrBalanced(r, a, k, next, thresholds);
+        std::fill(r + 2 * k, r + 4 * k, 0);
+        sqrBalanced(r + 4 * k, a + 2 * k, n2, next, thresholds);
 
-    static QBigNum mulMod(const QString& a, const QString& b, const QString& m)
-    {
-        return QBigNum::mulMod(QBigNum(a), QBigNum(b), QBigNum(m));
+        toom3Interpolate(r, n, k, n2, r1, rm1, rm2);
     }
 
-    static QBigNum mulMod(int64_t a, int64_t b, int64_t m)
+    // r[0..2n) = a[0..n) * b[0..n), picks schoolbook, Karatsuba, Toom-3 or NTT by length
+    inline void mulBalanced(uint64_t* r, const uint64_t* a, const uint64_t* b, int n, uint64_t* scratch, const MulThresholds& thresholds)
     {
-        return QBigNum::mulMod(QBigNum(a), QBigNum(b), QBigNum(m));
+        if (n >= thresholds.ntt)
+        {
+            mulNtt(r, a, n, b, n);
+        }
+        else if (n < thresholds.karatsuba || n < 2)
+        {
+            mulSchoolbook(r, a, n, b, n);
+        }
+        else if (n < thresholds.toom3 || n < 5)
+        {
+            mulKaratsuba(r, a, b, n, scratch, thresholds);
+        }
+        else
+        {
+            mulToom3(r, a, b, n, scratch, thresholds);
+        }
     }
 
-    // Non-const version: allows modification of data
-    uint64_t& operator[](size_t index)
+    // r[0..2n) = a[0..n)^2, picks schoolbook, Karatsuba, Toom-3 or NTT by length
+    inline void sqrBalanced(uint64_t* r, const uint64_t* a, int n, uint64_t* scratch, const MulThresholds& thresholds)
     {
-        if (index >= NUM_WORDS)
+        if (n >= thresholds.ntt)
         {
-            throw std::out_of_range("Index out of range");
+            mulNtt(r, a, n, a, n);
+        }
+        else if (n < thresholds.karatsuba || n < 2)
+        {
+            sqrSchoolbook(r, a, n);
+        }
+        else if (n < thresholds.toom3 || n < 5)
+        {
+            sqrKaratsuba(r, a, n, scratch, thresholds);
+        }
+        else
+        {
+            sqrToom3(r, a, n, scratch, thresholds);
         }
-        return data[index];
     }
 
-    // Const version: read-only access
-    const uint64_t& operator[](size_t index) const
+    // r[0..an+bn) = a[0..an) * b[0..bn), r must not overlap a or b
+    inline void mul(uint64_t* r, const uint64_t* a, int an, const uint64_t* b, int bn, uint64_t* scratch, const MulThresholds& thresholds)
     {
-        if (index >= NUM_WORDS)
+        if (an < bn)
         {
-            throw std::out_of_range("Index out of range");
+            std::swap(a, b);
+            std::swap(an, bn);
+        }
+        if (bn < thresholds.karatsuba)
+        {
+            mulSchoolbook(r, a, an, b, bn);
+            return;
+        }
+        if (bn >= thresholds.ntt)
+        {
+            mulNtt(r, a, an, b, bn);
+            return;
+        }
+        if (an == bn)
+        {
+            mulBalanced(r, a, b, an, scratch, thresholds);
+            return;
         }
-        return data[index];
-    }
 
-    static QBigNum powMod(const QBigNum& base, const QBigNum& exp, const QBigNum& mod)
-    {
-        QBigNum result = base.powMod(exp, mod);
-        return result;
+        /* Unbalanced, cut a into bn word pieces */
+        uint64_t* piece = scratch;
+        std::fill(r, r + an + bn, 0);
+        for (int i = 0; i < an; i += bn)
+        {
+            int len = qMin(bn, an - i);
+            mul(piece, b, bn, a + i, len, scratch + 2 * bn, thresholds);
+            addTo(r + i, an + bn - i, piece, len + bn);
+        }
     }
 
-    static QBigNum powMod(const QString& base, const QString& exp, const QString& mod)
+    // r[0..2n) = a[0..n)^2, r must not overlap a
+    inline void sqr(uint64_t* r, const uint64_t* a, int n, uint64_t* scratch, const MulThresholds& thresholds)
     {
-        QBigNum result = QBigNum(base).powMod(QBigNum(exp), QBigNum(mod));
-        return result;
+        sqrBalanced(r, a, n, scratch, thresholds);
     }
 
-    static QBigNum powMod(int64_t base, int64_t exp, const int64_t mod)
+    /* Half gcd for wide operands after Bernstein and Yang, "Fast constant-time gcd computation and modular
+       inversion" (2019). A run of n divsteps only looks at the low n bits of f and g, so the matrix for n steps
+       is the product of the matrices for the two halves, the second half running on the low bits the first
+       one leaves. Matrix entries stay within 2^n, done with mul the recursion costs O(M(n) log n) */
+    namespace HalfGcd
     {
-        QBigNum result = QBigNum(base).powMod(QBigNum(exp), QBigNum(mod));
-        return result;
-    }
+        // [u v; q r] taking (f, g) to 2^n times the pair n divsteps later, two's complement entries of words words
+        struct Matrix
+        {
+            int words;
+            std::array<std::vector<uint64_t>, 4> e;
+        };
 
-    QBigNum powMod(const QBigNum& exp, const QBigNum& mod) const
-    {
-        if (mod == 0)
+        // Multiply thresholds and a mul scratch that grows to the widest product of one gcd
+        struct Workspace
         {
-            throw std::invalid_argument("Modulus cannot be zero.");
-        }
+            const MulThresholds& thresholds;
+            std::vector<uint64_t> scratch;
+        };
 
-        if (exp < 0)
+        // Words of a two's complement number with room for +-2^bits
+        constexpr int signedWords(int bits)
         {
-            QBigNum base_inv = inverseMod(mod);
-            return powMod(base_inv, -exp, mod);
+            return bits / 64 + 1;
         }
 
-        QBigNum result = 1;    // Initialize result to 1
-        QBigNum b = *this % mod; // Reduce base modulo mod
-        QBigNum e = exp;       // Copy exponent for manipulation
-
-        while (e > 0)
+        // r[0..rn) = a[0..an) * b[0..bn) mod 2^(64 rn) for two's complement a and b
+        inline void mulSigned(uint64_t* r, int rn, const uint64_t* a, int an, const uint64_t* b, int bn, Workspace& ws)
         {
-            // If exponent is odd, multiply base with result
-            if (e.data[0] & 1)
+            bool aNegative = int64_t(a[an - 1]) < 0;
+            bool bNegative = int64_t(b[bn - 1]) < 0;
+            std::vector<uint64_t> ua(a, a + an);
+            std::vector<uint64_t> ub(b, b + bn);
+            if (aNegative)
             {
-                result = mulMod(result, b, mod);
+                negate(ua.data(), an);
             }
-            e >>= 1;       // Divide exponent by 2
-            b = mulMod(b, b, mod);// Square the base and reduce modulo mod
-        }
-
-        return result;
-    }
+            if (bNegative)
+            {
+                negate(ub.data(), bn);
+            }
+            an = normalizedSize(ua.data(), an);
+            bn = normalizedSize(ub.data(), bn);
 
-    QBigNum inverseMod(const QBigNum& mod) const
-    {
-        if (mod == 0)
-        {
-            throw std::invalid_argument("Modulus cannot be zero.");
+            std::fill(r, r + rn, 0);
+            if (an == 0 || bn == 0)
+            {
+                return;
+            }
+            std::vector<uint64_t> product(an + bn);
+            if (int(ws.scratch.size()) < mulScratchSize(qMax(an, bn)))
+            {
+                ws.scratch.resize(mulScratchSize(qMax(an, bn)));
+            }
+            mul(product.data(), ua.data(), an, ub.data(), bn, ws.scratch.data(), ws.thresholds);
+            std::copy(product.begin(), product.begin() + qMin(rn, an + bn), r);
+            if (aNegative != bNegative)
+            {
+                negate(r, rn);
+            }
         }
 
-        if (mod < 0)
+        // r[0..rn) = f a + g b mod 2^(64 rn) for two's complement f, a, g and b
+        inline void combine(uint64_t* r, int rn, const std::vector<uint64_t>& f, const uint64_t* a, int an,
+                            const std::vector<uint64_t>& g, const uint64_t* b, int bn, Workspace& ws)
         {
-            QBigNum result = inverseMod(-mod) + mod;
-            return result;
+            std::vector<uint64_t> t(rn);
+            mulSigned(r, rn, f.data(), int(f.size()), a, an, ws);
+            mulSigned(t.data(), rn, g.data(), int(g.size()), b, bn, ws);
+            add(r, r, t.data(), rn);
         }
 
-        QBigNum a = *this % mod; // Reduce `this` modulo `mod`
-        QBigNum m = mod;
-        QBigNum x0 = 0, x1 = 1; // Coefficients for the Extended Euclidean Algorithm
-        QBigNum t;
-
-        if (mod == 1)
+        // r[0..rn) = a[0..an) >> bits for two's complement a, r may be a
+        inline void shiftRightSigned(uint64_t* r, int rn, const uint64_t* a, int an, int bits)
         {
-            return 0;
+            uint64_t fill = (int64_t(a[an - 1]) < 0) ? ~0ULL : 0;
+            int words = bits / 64;
+            bits %= 64;
+            for (int i = 0; i < rn; ++i)
+            {
+                uint64_t low = (i + words < an) ? a[i + words] : fill;
+                uint64_t high = (i + words + 1 < an) ? a[i + words + 1] : fill;
+                r[i] = (bits == 0) ? low : (low >> bits) | (high << (64 - bits));
+            }
         }
 
-        while (a > 1)
+        // (a, b) = (u a + v b, q a + r b) mod 2^(64 n) in place, |u| + |v| and |q| + |r| at most 2^62
+        inline void apply(uint64_t* a, uint64_t* b, int n, int64_t u, int64_t v, int64_t q, int64_t r)
         {
-
-            if (m == 0)
+            __int128 carryA = 0;
+            __int128 carryB = 0;
+            for (int i = 0; i < n; ++i)
             {
-                throw std::invalid_argument("Inverse does not exist.");
+                __int128 x = __int128(a[i]) * u + __int128(b[i]) * v + carryA;
+                __int128 y = __int128(a[i]) * q + __int128(b[i]) * r + carryB;
+                a[i] = uint64_t(x);
+                b[i] = uint64_t(y);
+                carryA = x >> 64;
+                carryB = y >> 64;
             }
-
-            auto [q, r] = a / m;
-            a = m;
-            m = r;
-
-            // Update `x0` and `x1`
-            t = x0;
-            x0 = x1 - q * x0; // TODO: can this overflow ?
-            x1 = t;
         }
 
-        // If `a` is not 1, no modular inverse exists
-        if (a != 1)
+        // Up to 62 divsteps on the low words of f and g, f odd. Returns the new delta and sets [u v; q r]
+        inline int64_t divsteps(int64_t delta, uint64_t f, uint64_t g, int steps, int64_t& u, int64_t& v, int64_t& q, int64_t& r)
         {
-            throw std::invalid_argument("Inverse does not exist.");
-        }
+            u = 1;
+            v = 0;
+            q = 0;
+            r = 1;
+            int i = 0;
+            for (;;)
+            {
+                /* A run of even g only halves it */
+                int zeros = (g != 0) ? qMin(__builtin_ctzll(g), steps - i) : steps - i;
+                g >>= zeros;
+                u *= int64_t(1) << zeros;
+                v *= int64_t(1) << zeros;
+                delta += zeros;
+                i += zeros;
+                if (i == steps)
+                {
+                    return delta;
+                }
 
-        // Make sure result is positive
-        if (x1 < 0)
-        {
-            x1 += mod;
+                if (delta > 0)
+                {
+                    int64_t twiceQ = 2 * q;
+                    int64_t twiceR = 2 * r;
+                    q -= u;
+                    r -= v;
+                    u = twiceQ;
+                    v = twiceR;
+                    uint64_t oldF = f;
+                    f = g;
+                    g = (g - oldF) >> 1;
+                    delta = 1 - delta;
+                }
+                else
+                {
+                    q += u;
+                    r += v;
+                    u *= 2;
+                    v *= 2;
+                    g = (g + f) >> 1;
+                    delta = 1 + delta;
+                }
+                ++i;
+            }
         }
 
-        return x1;
-    }
-
-    static QBigNum gcd(QBigNum a, QBigNum b)
-    {
-        if (a == 0)
-        {
-            return b;
-        }
-        if (b == 0)
+        // Matrix and new delta for n divsteps from f and g, f odd. Only the low n bits of f[] and g[] are read
+        inline int64_t jump(int64_t delta, const uint64_t* f, const uint64_t* g, int n, Matrix& m, Workspace& ws)
         {
-            return a;
-        }
+            int w = (n + 63) / 64;
+            m.words = signedWords(n);
+            if (w < ws.thresholds.karatsuba)
+            {
+                /* Products this short are schoolbook anyway, so run the steps 62 at a time on the low words */
+                std::vector<uint64_t> x(f, f + w);
+                std::vector<uint64_t> y(g, g + w);
+                for (int i = 0; i < 4; ++i)
+                {
+                    m.e[i].assign(m.words, 0);
+                }
+                m.e[0][0] = 1;
+                m.e[3][0] = 1;
+                /* Only the low n - done bits of x and y still matter and the entries fit signedWords(done) words */
+                int words = 1;
+                for (int done = 0; done < n;)
+                {
+                    int steps = qMin(GCD_STEPS, n - done);
+                    int live = (n - done + 63) / 64;
+                    int64_t u, v, q, r;
+                    delta = divsteps(delta, x[0], y[0], steps, u, v, q, r);
+                    apply(x.data(), y.data(), live, u, v, q, r);
+                    shiftRightSigned(x.data(), live, x.data(), live, steps);
+                    shiftRightSigned(y.data(), live, y.data(), live, steps);
+                    done += steps;
+
+                    int grown = signedWords(done);
+                    for (std::vector<uint64_t>& entry : m.e)
+                    {
+                        std::fill(entry.begin() + words, entry.begin() + grown, (int64_t(entry[words - 1]) < 0) ? ~0ULL : 0);
+                    }
+                    words = grown;
+                    apply(m.e[0].data(), m.e[2].data(), words, u, v, q, r);
+                    apply(m.e[1].data(), m.e[3].data(), words, u, v, q, r);
+                }
+                for (std::vector<uint64_t>& entry : m.e)
+                {
+                    std::fill(entry.begin() + words, entry.end(), (int64_t(entry[words - 1]) < 0) ? ~0ULL : 0);
+                }
+                return delta;
+            }
 
-        a = QBigNum::abs(a);
-        b = QBigNum::abs(b);
+            Matrix m1;
+            int n1 = n / 2;
+            delta = jump(delta, f, g, n1, m1, ws);
+
+            /* The first half leaves f and g known mod 2^(n - n1) */
+            std::vector<uint64_t> x(w);
+            std::vector<uint64_t> y(w);
+            combine(x.data(), w, m1.e[0], f, w, m1.e[1], g, w, ws);
+            combine(y.data(), w, m1.e[2], f, w, m1.e[3], g, w, ws);
+            shiftRightSigned(x.data(), w, x.data(), w, n1);
+            shiftRightSigned(y.data(), w, y.data(), w, n1);
+
+            Matrix m2;
+            delta = jump(delta, x.data(), y.data(), n - n1, m2, ws);
 
-        uint shift = 0;
+            /* m = m2 m1 */
+            for (int i = 0; i < 4; ++i)
+            {
+                const std::vector<uint64_t>& left0 = m2.e[i & 2];
+                const std::vector<uint64_t>& left1 = m2.e[(i & 2) + 1];
+                const std::vector<uint64_t>& right0 = m1.e[i & 1];
+                const std::vector<uint64_t>& right1 = m1.e[(i & 1) + 2];
+                m.e[i].resize(m.words);
+                combine(m.e[i].data(), m.words, left0, right0.data(), m1.words, left1, right1.data(), m1.words, ws);
+            }
+            return delta;
+        }
 
-        // Remove common factors of 2
-        while (((a.data[0] | b.data[0]) & 1) == 0) // Both are even
+        // Words of the wider of |f[0..n)| and |g[0..n)| for two's complement f and g
+        inline int magnitudeWords(const uint64_t* f, const uint64_t* g, int n)
         {
-            a >>= 1;
-            b >>= 1;
-            shift++;
+            int words = 0;
+            for (const uint64_t* x : {f, g})
+            {
+                uint64_t fill = (int64_t(x[n - 1]) < 0) ? ~0ULL : 0;
+                int i = n;
+                while (i > 0 && x[i - 1] == fill)
+                {
+                    --i;
+                }
+                words = qMax(words, i + 1);
+            }
+            return qMin(words, n);
         }
 
-        while ((a.data[0] & 1) == 0) // Remove factors of 2 from a
+        // One chunk of divsteps on f and g of n two's complement words, exactly: (f, g) = m (f, g) / 2^steps.
+        // Each chunk takes 62 steps per word, which shortens the numbers by about a third
+        inline int64_t reduce(int64_t delta, std::vector<uint64_t>& f, std::vector<uint64_t>& g, int len, Matrix& m, Workspace& ws)
         {
-            a >>= 1;
+            int n = int(f.size());
+            int steps = GCD_STEPS * len;
+            delta = jump(delta, f.data(), g.data(), steps, m, ws);
+
+            int rn = n + m.words;
+            std::vector<uint64_t> x(rn);
+            std::vector<uint64_t> y(rn);
+            combine(x.data(), rn, m.e[0], f.data(), n, m.e[1], g.data(), n, ws);
+            combine(y.data(), rn, m.e[2], f.data(), n, m.e[3], g.data(), n, ws);
+            shiftRightSigned(f.data(), n, x.data(), rn, steps);
+            shiftRightSigned(g.data(), n, y.data(), rn, steps);
+            return delta;
         }
 
-        while (b != 0)
+        // |x[0..n]| into r[0..n], returns true when x was negative
+        inline bool magnitude(uint64_t* r, const std::vector<uint64_t>& x)
         {
-            while ((b.data[0] & 1) == 0) // Remove factors of 2 from b
+            std::copy(x.begin(), x.end(), r);
+            bool negative = int64_t(x.back()) < 0;
+            if (negative)
             {
-                b >>= 1;
+                negate(r, int(x.size()));
             }
+            return negative;
+        }
 
-            if (a > b)
+        // gcd(a, b) for b odd like gcdOdd, which takes over once the numbers are below threshold words
+        inline int gcd(uint64_t* a, uint64_t* b, int n, uint64_t* t, int threshold, const MulThresholds& thresholds)
+        {
+            Workspace ws{thresholds, {}};
+            std::vector<uint64_t> f(b, b + n);
+            std::vector<uint64_t> g(a, a + n);
+            f.push_back(0);
+            g.push_back(0);
+            int64_t delta = 1;
+            for (;;)
             {
-                QBigNum temp = a;
-                a = b;
-                b = temp;
+                int len = magnitudeWords(f.data(), g.data(), n + 1);
+                if (len < threshold || normalizedSize(g.data(), n + 1) == 0)
+                {
+                    break;
+                }
+                Matrix m;
+                delta = reduce(delta, f, g, len, m, ws);
             }
 
-            b = b - a; // Reduce b
-        }
-
-        // Restore common factors of 2
-        return a << shift;
-    }
-
-    static QBigNum gcd(const QString& a, const QString& b)
-    {
-        return gcd(QBigNum(a), QBigNum(b));
-    }
+            magnitude(b, f);
+            magnitude(a, g);
+            return gcdOdd(a, b, n, t);
+        }
+
+        // x^-1 mod m like inverseOdd. The cofactors d and e with x d == f and x e == g mod m take each chunk's
+        // matrix too, the division by 2^steps made exact by adding a multiple of m as in Montgomery reduction.
+        // Below threshold words gcdOddCofactors takes over
+        inline bool inverse(uint64_t* r, const uint64_t* x, const uint64_t* m, int n, uint64_t* t, int threshold, const MulThresholds& thresholds)
+        {
+            Workspace ws{thresholds, {}};
+            std::vector<uint64_t> f(m, m + n);
+            std::vector<uint64_t> g(x, x + n);
+            std::vector<uint64_t> d(n + 1, 0);
+            std::vector<uint64_t> e(n + 1, 0);
+            f.push_back(0);
+            g.push_back(0);
+            e[0] = 1;
+
+            /* m^-1 mod 2^(64 (n + 1)) by Newton's iteration, each step doubles the correct words */
+            std::vector<uint64_t> mInverse(n + 1, 0);
+            std::vector<uint64_t> product(n + 1);
+            std::vector<uint64_t> correction(n + 1);
+            const uint64_t two = 2;
+            mInverse[0] = m[0];
+            for (int i = 0; i < 5; ++i)
+            {
+                mInverse[0] *= 2 - m[0] * mInverse[0];
+            }
+            for (int words = 1; words < n + 1;)
+            {
+                words = qMin(2 * words, n + 1);
+                mulLow(product.data(), words, f.data(), words, mInverse.data(), words);
+                negate(product.data(), words);
+                addTo(product.data(), words, &two, 1);
+                mulLow(correction.data(), words, mInverse.data(), words, product.data(), words);
+                mInverse.swap(correction);
+            }
 
-    static QBigNum gcd(int64_t a, int64_t b)
-    {
-        return gcd(QBigNum(a), QBigNum(b));
-    }
+            int64_t delta = 1;
+            for (;;)
+            {
+                int len = magnitudeWords(f.data(), g.data(), n + 1);
+                if (len < threshold || normalizedSize(g.data(), n + 1) == 0)
+                {
+                    break;
+                }
+                Matrix mat;
+                delta = reduce(delta, f, g, len, mat, ws);
+
+                int steps = GCD_STEPS * len;
+                int kw = (steps + 63) / 64;
+                int rn = n + 1 + mat.words + 1;
+                std::vector<uint64_t> next[2];
+                for (int row = 0; row < 2; ++row)
+                {
+                    std::vector<uint64_t> sum(rn);
+                    combine(sum.data(), rn, mat.e[2 * row], d.data(), n + 1, mat.e[2 * row + 1], e.data(), n + 1, ws);
+
+                    /* k = -sum / m mod 2^steps makes sum + k m divisible by 2^steps */
+                    std::vector<uint64_t> k(kw);
+                    std::vector<uint64_t> low(sum.begin(), sum.begin() + kw);
+                    negate(low.data(), kw);
+                    mulLow(k.data(), kw, low.data(), kw, mInverse.data(), kw);
+                    if (steps % 64)
+                    {
+                        k[kw - 1] &= (uint64_t(1) << (steps % 64)) - 1;
+                    }
+                    std::vector<uint64_t> km(kw + n);
+                    if (int(ws.scratch.size()) < mulScratchSize(qMax(kw, n)))
+                    {
+                        ws.scratch.resize(mulScratchSize(qMax(kw, n)));
+                    }
+                    mul(km.data(), k.data(), kw, m, n, ws.scratch.data(), thresholds);
+                    addTo(sum.data(), rn, km.data(), kw + n);
+
+                    /* |u d + v e| < m 2^steps and k m < m 2^steps leave the quotient in (-m, 2m) */
+                    next[row].resize(n + 1);
+                    shiftRightSigned(next[row].data(), n + 1, sum.data(), rn, steps);
+                    if (int64_t(next[row][n]) < 0)
+                    {
+                        addTo(next[row].data(), n + 1, m, n);
+                    }
+                    else if (next[row][n] != 0 || compare(next[row].data(), m, n) >= 0)
+                    {
+                        subFrom(next[row].data(), n + 1, m, n);
+                    }
+                }
+                d = next[0];
+                e = next[1];
+            }
 
-    static QBigNum gcd_slow(QBigNum a, QBigNum b)
-    {
-        if (a == 0)
-        {
-            return b;
-        }
-        if (b == 0)
-        {
-            return a;
-        }
-        a = QBigNum::abs(a);
-        b = QBigNum::abs(b);
-        while (b != 0 && a != 0)
-        {
-            if (b < a)
+            /* gcdOddCofactors wants nonnegative numbers, negating one negates its cofactor */
+            uint64_t* a = t;
+            uint64_t* b = t + (n + 1);
+            uint64_t* u = t + 2 * (n + 1);
+            if (magnitude(b, f) && normalizedSize(d.data(), n) != 0)
             {
-                a %= b;
+                sub(d.data(), m, d.data(), n);
             }
-            else
+            if (magnitude(a, g) && normalizedSize(e.data(), n) != 0)
             {
-                b %= a;
+                sub(e.data(), m, e.data(), n);
             }
+            std::copy(e.begin(), e.end(), u);
+            std::copy(d.begin(), d.end(), r);
+            return gcdOddCofactors(a, b, u, r, m, n, 0 - mInverse[0], t + 3 * (n + 1));
         }
-        if (a == 0)
-        {
-            return b;
-        }
-        return a;
     }
+}
 
-    static QBigNum gcd_slow(const QString& a, const QString& b)
-    {
-        return gcd_slow(QBigNum(a), QBigNum(b));
-    }
+/* Word lengths where multiplication and gcd switch algorithm, specialise for a width to tune it separately */
+template <size_t Bits>
+struct QBigNumThresholds
+{
+    static constexpr int karatsuba = QBIGNUM_KARATSUBA_THRESHOLD;
+    static constexpr int toom3 = QBIGNUM_TOOM3_THRESHOLD;
+    static constexpr int ntt = QBIGNUM_NTT_THRESHOLD;
+    static constexpr int hgcd = QBIGNUM_HGCD_THRESHOLD;
+    static constexpr int hgcdInverse = QBIGNUM_HGCD_INVERSE_THRESHOLD;
+};
 
-    static QBigNum gcd_slow(int64_t a, int64_t b)
-    {
-        return gcd_slow(QBigNum(a), QBigNum(b));
-    }
+/* The half gcd thresholds came after the multiply ones, a specialisation that leaves them out gets the macros */
+template <typename Thresholds, typename = void>
+struct QBigNumHgcdThreshold : std::integral_constant<int, QBIGNUM_HGCD_THRESHOLD>
+{
+};
 
-    /* Friends */
+template <typename Thresholds>
+struct QBigNumHgcdThreshold<Thresholds, std::void_t<decltype(Thresholds::hgcd)>> : std::integral_constant<int, Thresholds::hgcd>
+{
+};
 
-    friend QBigNum operator-(int64_t lhs, const QBigNum& rhs)
-    {
-        return QBigNum(lhs) - rhs;
-    }
+template <typename Thresholds, typename = void>
+struct QBigNumHgcdInverseThreshold : std::integral_constant<int, QBIGNUM_HGCD_INVERSE_THRESHOLD>
+{
+};
 
-    friend QBigNum operator+(int64_t lhs, const QBigNum& rhs)
-    {
-        return QBigNum(lhs) + rhs;
-    }
+template <typename Thresholds>
+struct QBigNumHgcdInverseThreshold<Thresholds, std::void_t<decltype(Thresholds::hgcdInverse)>> : std::integral_constant<int, Thresholds::hgcdInverse>
+{
+};
 
-    friend QBigNum operator*(int64_t lhs, const QBigNum& rhs)
-    {
-        return QBigNum(lhs) * rhs;
-    }
+template <size_t Bits>
+class QBigNumBarrett;
 
-    friend QBigNum operator%(int64_t lhs, const QBigNum& rhs)
-    {
-        return QBigNum(lhs) % rhs;
-    }
+template <size_t Bits>
+class QBigNumMontgomery;
 
-    /* Hany operations */
+template <size_t Bits>
+class QBigNumSolinas;
 
-    QBigNum operator-() const
-    {
-        return this->twosComplement();
-    }
+template <size_t Bits>
+class QBigNum
+{
+    template <size_t OtherBits>
+    friend class QBigNum;
+    template <size_t OtherBits>
+    friend class QBigNumBarrett;
+    template <size_t OtherBits>
+    friend class QBigNumMontgomery;
+    template <size_t OtherBits>
+    friend class QBigNumSolinas;
 
-    QBigNum operator<<(int bits) const
-    {
-        QBigNum result = *this;
-        result <<= bits;
-        return result;
-    }
+private:
+    /* Limbs live inside the object so numbers are trivially copyable and temporaries never allocate */
+    alignas(QBIGNUM_ALIGNMENT) std::array<uint64_t, NUM_WORDS(Bits)> data;
 
-    QBigNum operator>>(int bits) const
+    template <size_t ABits, size_t BBits>
+    static void copy(const QBigNum<ABits>& from, QBigNum<BBits>& to)
     {
-        QBigNum result = *this;
-        result >>= bits;
-        return result;
-    }
+        size_t minWords = qMin(NUM_WORDS(ABits), NUM_WORDS(BBits));
+        for (size_t i = 0; i < minWords; ++i)
+        {
+            to[i] = from[i];
+        }
+        if (from.isNegative())
+        {
+            for (size_t i = minWords; i < NUM_WORDS(BBits); ++i)
+            {
+                to[i] = ~0ULL;
+            }
+        }
 
-    QBigNum operator+(int64_t scalar) const
-    {
-        QBigNum result = *this;
-        result += scalar;
-        return result;
+        if (to.isNegative() != from.isNegative())
+        {
+            throw std::overflow_error("Copy overflow");
+        }
     }
 
-    QBigNum operator-(int64_t scalar) const
-    {
-        QBigNum result = *this;
-        result -= scalar;
-        return result;
-    }
+    static constexpr QBigNumKernels::MulThresholds mulThresholds{QBigNumThresholds<Bits>::karatsuba, QBigNumThresholds<Bits>::toom3, QBigNumThresholds<Bits>::ntt};
+    static constexpr int hgcdThreshold = QBigNumHgcdThreshold<QBigNumThresholds<Bits>>::value;
+    static constexpr int hgcdInverseThreshold = QBigNumHgcdInverseThreshold<QBigNumThresholds<Bits>>::value;
 
-    QBigNum operator*(int64_t scalar) const
-    {
-        QBigNum result = *this;
-        result *= scalar;
-        return result;
-    }
+    /* Below the NTT threshold operands never need more scratch than this, the NTT itself uses the heap */
+    static constexpr int scratchWords = QBigNumKernels::mulScratchSize(qMin(int(NUM_WORDS(Bits)), mulThresholds.ntt));
 
-    QBigNum operator+(const QBigNum& other) const
+    /* product[0..na+nb) = a * b for magnitudes, scratch only lives on the stack past the schoolbook sizes */
+    static void mulMagnitudes(uint64_t* product, const uint64_t* a, int na, const uint64_t* b, int nb)
     {
-        QBigNum result = *this;
-        result += other;
-        return result;
+        if (qMin(na, nb) < mulThresholds.karatsuba)
+        {
+            QBigNumKernels::mulSchoolbook(product, a, na, b, nb);
+            return;
+        }
+        if (qMin(na, nb) >= mulThresholds.ntt)
+        {
+            QBigNumKernels::mulNtt(product, a, na, b, nb);
+            return;
+        }
+        std::array<uint64_t, scratchWords> scratch;
+        QBigNumKernels::mul(product, a, na, b, nb, scratch.data(), mulThresholds);
     }
 
-    QBigNum operator-(const QBigNum& other) const
+    /* product[0..2n) = a^2 for a magnitude */
+    static void sqrMagnitude(uint64_t* product, const uint64_t* a, int n)
     {
-        QBigNum result = *this;
-        result -= other;
-        return result;
+        if (n < mulThresholds.karatsuba)
+        {
+            QBigNumKernels::sqrSchoolbook(product, a, n);
+            return;
+        }
+        if (n >= mulThresholds.ntt)
+        {
+            QBigNumKernels::mulNtt(product, a, n, a, n);
+            return;
+        }
+        std::array<uint64_t, scratchWords> scratch;
+        QBigNumKernels::sqr(product, a, n, scratch.data(), mulThresholds);
     }
 
-    QBigNum& operator/=(const QBigNum& divisor)
+    /* Signed full product of a and b as 2 * NUM_WORDS words of two's complement */
+    static void mulFull(std::array<uint64_t, 2 * NUM_WORDS(Bits)>& product, const QBigNum& a, const QBigNum& b)
     {
-        auto [quotient, remainder] = *this / divisor;
-        *this = quotient;
-        return *this;
-    }
+        QBigNum ua = abs(a);
+        QBigNum ub = abs(b);
+        int na = QBigNumKernels::normalizedSize(ua.data.data(), NUM_WORDS(Bits));
+        int nb = QBigNumKernels::normalizedSize(ub.data.data(), NUM_WORDS(Bits));
 
-    QBigNum operator++(int)
-    {
-        QBigNum temp = *this;
-        ++(*this); // Use pre-increment
-        return temp;
-    }
+        mulMagnitudes(product.data(), ua.data.data(), na, ub.data.data(), nb);
+        std::fill(product.begin() + na + nb, product.end(), 0);
 
-    QBigNum operator--(int)
-    {
-        QBigNum temp = *this;
-        --(*this); // Use pre-decrement
-        return temp;
+        if (a.isNegative() != b.isNegative())
+        {
+            QBigNumKernels::negate(product.data(), product.size());
+        }
     }
 
-    QBigNum& operator%=(const QBigNum& divisor)
+    /* Window width for sliding window exponentiation, the odd power table doubles with each extra bit so it
+       only pays for itself on longer exponents */
+    static constexpr int windowSize(int expBits)
     {
-        auto [quotient, remainder] = *this / divisor;
-        *this = remainder;
-        return *this;
+        return (expBits <= 8) ? 1 : (expBits <= 24) ? 2 : (expBits <= 80) ? 3 : (expBits <= 240) ? 4 : (expBits <= 672) ? 5 : 6;
     }
 
-    QBigNum operator%(const QBigNum& divisor) const
+    /* a^exp for exp >= 0 by left to right sliding windows. mul and sqr work in whatever form the caller keeps
+       its residues, plain or Montgomery, and one is 1 in that form. The odd powers a, a^3 ... a^(2^w - 1) are
+       tabled first, after that each window of w bits ending in a 1 costs one multiply */
+    template <typename Mul, typename Sqr>
+    static QBigNum windowedPow(const QBigNum& a, const QBigNum& exp, const QBigNum& one, Mul mul, Sqr sqr)
     {
-        QBigNum remainder = *this;
-        remainder %= divisor;
-        return remainder;
-    }
+        int bits = exp.bitLength();
+        if (bits == 0)
+        {
+            return one;
+        }
 
-    QBigNum operator*(const QBigNum& other) const
-    {
-        QBigNum result = *this;
-        result *= other;
+        int w = windowSize(bits);
+        std::vector<QBigNum> oddPowers(1 << (w - 1));
+        oddPowers[0] = a;
+        if (w > 1)
+        {
+            QBigNum a2 = sqr(a);
+            for (size_t i = 1; i < oddPowers.size(); ++i)
+            {
+                oddPowers[i] = mul(oddPowers[i - 1], a2);
+            }
+        }
+
+        /* The top bit is always set so the first window starts the result, no squarings of one */
+        QBigNum result = one;
+        bool started = false;
+        int i = bits - 1;
+        while (i >= 0)
+        {
+            if (!exp.testBit(i))
+            {
+                result = sqr(result);
+                --i;
+                continue;
+            }
+
+            int j = qMax(i - w + 1, 0);
+            while (!exp.testBit(j))
+            {
+                ++j;
+            }
+            int window = 0;
+            for (int l = i; l >= j; --l)
+            {
+                window = (window << 1) | exp.testBit(l);
+                if (started)
+                {
+                    result = sqr(result);
+                }
+            }
+            result = started ? mul(result, oddPowers[window >> 1]) : oddPowers[window >> 1];
+            started = true;
+            i = j - 1;
+        }
         return result;
     }
 
-    QBigNum& operator%=(int64_t scalar)
+    /* Joint window width for two exponents of up to expBits bits. The table of a0^u a1^v grows by four with
+       each extra bit, about 3 4^(w - 1) multiplies, against one multiply per w + 1/3 bits of exponent */
+    static constexpr int jointWindowSize(int expBits)
     {
-        QBigNum divisor(scalar);
-        *this %= divisor;
-        return *this;
+        return (expBits <= 40) ? 1 : (expBits <= 296) ? 2 : (expBits <= 2140) ? 3 : 4;
     }
 
-    QBigNum& operator/=(int64_t scalar)
+    /* prod a[i]^exps[i] for exps[i] >= 0 with one shared chain of squarings. Two bases slide one window across
+       both exponents at once (Shamir's trick widened to w bits), the table holds a0^u a1^v for u, v < 2^w with
+       u or v odd, so each window ends on a column with a set bit and costs one multiply. More bases each get
+       their own odd power table and sliding windows (Straus), and a base's multiply lands on the bit where its
+       window ends */
+    template <typename Mul, typename Sqr>
+    static QBigNum multiWindowedPow(const std::vector<QBigNum>& a, const std::vector<QBigNum>& exps, const QBigNum& one, Mul mul, Sqr sqr)
     {
-        QBigNum divisor(scalar);
-        auto [quotient, remainder] = *this / divisor;
-        *this = quotient;
-        return *this;
-    }
+        int bits = 0;
+        for (const QBigNum& e : exps)
+        {
+            bits = qMax(bits, e.bitLength());
+        }
 
-    QBigNum operator%(int64_t scalar) const
+        QBigNum result = one;
+        bool started = false;
+        if (a.size() == 2)
+        {
+            int w = jointWindowSize(bits);
+            int size = 1 << w;
+            std::vector<QBigNum> powers0(size), powers1(size);
+            powers0[1] = a[0];
+            powers1[1] = a[1];
+            for (int u = 2; u < size; ++u)
+            {
+                powers0[u] = (u == 2) ? sqr(a[0]) : mul(powers0[u - 1], a[0]);
+                powers1[u] = (u == 2) ? sqr(a[1]) : mul(powers1[u - 1], a[1]);
+            }
+            std::vector<QBigNum> table(size * size);
+            for (int u = 0; u < size; ++u)
+            {
+                for (int v = 0; v < size; ++v)
+                {
+                    if ((u | v) & 1)
+                    {
+                        table[u * size + v] = (u == 0) ? powers1[v] : (v == 0) ? powers0[u] : mul(powers0[u], powers1[v]);
+                    }
+                }
+            }
+
+            int i = bits - 1;
+            while (i >= 0)
+            {
+                if (!exps[0].testBit(i) && !exps[1].testBit(i))
+                {
+                    if (started)
+                    {
+                        result = sqr(result);
+                    }
+                    --i;
+                    continue;
+                }
+                int j = qMax(i - w + 1, 0);
+                while (!exps[0].testBit(j) && !exps[1].testBit(j))
+                {
+                    ++j;
+                }
+                int u = 0;
+                int v = 0;
+                for (int l = i; l >= j; --l)
+                {
+                    u = (u << 1) | exps[0].testBit(l);
+                    v = (v << 1) | exps[1].testBit(l);
+                    if (started)
+                    {
+                        result = sqr(result);
+                    }
+                }
+                result = started ? mul(result, table[u * size + v]) : table[u * size + v];
+                started = true;
+                i = j - 1;
+            }
+            return result;
+        }
+
+        /* Per base odd power tables and the (bit, table index) of each window, highest bit first */
+        std::vector<std::vector<QBigNum>> oddPowers(a.size());
+        std::vector<std::vector<std::pair<int, int>>> windows(a.size());
+        for (size_t k = 0; k < a.size(); ++k)
+        {
+            int w = windowSize(exps[k].bitLength());
+            oddPowers[k].resize(1 << (w - 1));
+            oddPowers[k][0] = a[k];
+            if (w > 1)
+            {
+                QBigNum a2 = sqr(a[k]);
+                for (size_t i = 1; i < oddPowers[k].size(); ++i)
+                {
+                    oddPowers[k][i] = mul(oddPowers[k][i - 1], a2);
+                }
+            }
+
+            int i = exps[k].bitLength() - 1;
+            while (i >= 0)
+            {
+                if (!exps[k].testBit(i))
+                {
+                    --i;
+                    continue;
+                }
+                int j = qMax(i - w + 1, 0);
+                while (!exps[k].testBit(j))
+                {
+                    ++j;
+                }
+                int window = 0;
+                for (int l = i; l >= j; --l)
+                {
+                    window = (window << 1) | exps[k].testBit(l);
+                }
+                windows[k].push_back({j, window >> 1});
+                i = j - 1;
+            }
+        }
+
+        std::vector<size_t> next(a.size(), 0);
+        for (int i = bits - 1; i >= 0; --i)
+        {
+            if (started)
+            {
+                result = sqr(result);
+            }
+            for (size_t k = 0; k < a.size(); ++k)
+            {
+                if (next[k] < windows[k].size() && windows[k][next[k]].first == i)
+                {
+                    const QBigNum& power = oddPowers[k][windows[k][next[k]].second];
+                    result = started ? mul(result, power) : power;
+                    started = true;
+                    ++next[k];
+                }
+            }
+        }
+        return result;
+    }
+
+    /* Remainder of a double width product, sign follows m like operator% */
+    static QBigNum reduceWide(QBigNum<2 * Bits> product, const QBigNum& m)
     {
-        QBigNum divisor(scalar);
-        QBigNum remainder = *this;
-        remainder %= divisor;
+        QBigNum<(2*Bits)> mbig;
+        QBigNum res;
+
+        uint bitCount = qMax(product.bitLength(), m.bitLength());
+        if (bitCount >= Bits)
+        {
+            /* Do the mod operation in the bigger space */
+            copy(m, mbig);
+            product %= mbig;
+            copy(product, res);
+        }
+        else
+        {
+            copy(product, res);
+            res %= m;
+        }
+
+        return res;
+    }
+
+    /* Floor division in place by a signed scalar through divmod1, the remainder takes the sign of the scalar */
+    int64_t divModScalar(int64_t scalar)
+    {
+        uint64_t magnitude = (scalar < 0) ? 0 - static_cast<uint64_t>(scalar) : static_cast<uint64_t>(scalar);
+        int64_t remainder = static_cast<int64_t>(divmod1(magnitude));
+        if (scalar < 0)
+        {
+            *this = -*this;
+            if (remainder != 0)
+            {
+                *this -= 1;
+                remainder += scalar;
+            }
+        }
         return remainder;
     }
 
-    /* Comparisons. */
+    /* Remainder only version of divModScalar */
+    int64_t modScalar(int64_t scalar) const
+    {
+        uint64_t magnitude = (scalar < 0) ? 0 - static_cast<uint64_t>(scalar) : static_cast<uint64_t>(scalar);
+        int64_t remainder = static_cast<int64_t>(mod1(magnitude));
+        if (scalar < 0 && remainder != 0)
+        {
+            remainder += scalar;
+        }
+        return remainder;
+    }
 
-    bool operator==(const QString &decimalStr) const
+    /* Extended Euclid for a in [0, mod), the cofactors never exceed mod so q * x0 cannot overflow */
+    static QBigNum inverseModEuclid(QBigNum a, QBigNum m)
     {
-        QBigNum other = decimalStr;
-        return *this == other;
+        QBigNum mod = m;
+        QBigNum x0 = 0, x1 = 1; // Coefficients for the Extended Euclidean Algorithm
+        QBigNum t;
+
+        while (a > 1)
+        {
+
+            if (m == 0)
+            {
+                throw std::invalid_argument("Inverse does not exist.");
+            }
+
+            auto [q, r] = a / m;
+            a = m;
+            m = r;
+
+            // Update `x0` and `x1`
+            t = x0;
+            x0 = x1 - q * x0;
+            x1 = t;
+        }
+
+        // If `a` is not 1, no modular inverse exists
+        if (a != 1)
+        {
+            throw std::invalid_argument("Inverse does not exist.");
+        }
+
+        // Make sure result is positive
+        if (x1 < 0)
+        {
+            x1 += mod;
+        }
+
+        return x1;
     }
 
-    bool operator==(int64_t scalar) const
+    /* Whether a and b, each of NUM_WORDS words, are long enough for the half gcd */
+    static bool usesHalfGcd(const uint64_t* a, const uint64_t* b, int threshold)
     {
-        QBigNum other = QBigNum(scalar);
-        return *this == other;
+        return int(NUM_WORDS(Bits)) >= threshold &&
+               qMax(QBigNumKernels::normalizedSize(a, NUM_WORDS(Bits)), QBigNumKernels::normalizedSize(b, NUM_WORDS(Bits))) >= threshold;
+    }
+
+protected:
+public:
+    static constexpr int NUM_BITS = Bits;
+    static constexpr int NUM_WORDS = NUM_WORDS(Bits);
+
+    constexpr QBigNum()
+        : data{}
+    {
+    }
+
+    constexpr QBigNum(int64_t scalar)
+        : data{}
+    {
+        data[0] = (scalar < 0) ? -static_cast<uint64_t>(scalar) : static_cast<uint64_t>(scalar);
+
+        if (scalar < 0)
+        {
+            *this = -*this;
+        }
+    }
+
+    QBigNum(const QString& number)
+    {
+        if (number.trimmed().toUpper().startsWith("0X") ||
+            number.trimmed().toUpper().startsWith("-0X"))
+        {
+            *this = fromHex(number);
+        }
+        else
+        {
+            *this = fromDecimal(number);
+        }
+    }
+
+    /* Assignment */
+
+    QBigNum& operator=(int64_t scalar)
+    {
+        *this = QBigNum(scalar);
+        return *this;
+    }
+
+    QBigNum& operator=(const QString& number)
+    {
+        *this = QBigNum(number);
+        return *this;
+    }
+
+    /* Shift operations */
+
+    constexpr QBigNum& operator<<=(int bits)
+    {
+        if (bits == 0)
+        {
+            return *this;
+        }
+        QBigNumKernels::shiftLeftFixed<NUM_WORDS>(data.data(), bits);
+        return *this;
+    }
+
+    constexpr QBigNum& operator>>=(int bits)
+    {
+        if (bits == 0)
+        {
+            return *this;
+        }
+        QBigNumKernels::shiftRightFixed<NUM_WORDS>(data.data(), bits);
+        return *this;
+    }
+
+    /* Scaler operations */
+    constexpr QBigNum& operator*=(int64_t scalar)
+    {
+        if (scalar < 0)
+        {
+            scalar *= -1;
+            *this = -*this;
+        }
+        QBigNumKernels::mul1Fixed<NUM_WORDS>(data.data(), static_cast<uint64_t>(scalar));
+        return *this;
+    }
+
+    QBigNum& operator+=(int64_t scalar)
+    {
+        if (scalar == 0)
+        {
+            return *this; // No change for zero
+        }
+
+        // Handle negative scalar
+        if (scalar < 0)
+        {
+            // Convert scalar to positive for subtraction
+            uint64_t absScalar = static_cast<uint64_t>(-scalar);
+            return *this -= absScalar; // Use subtraction for negative numbers
+        }
+
+        // Handle positive scalar
+#if defined(HAS_ADCINTRIN)
+        uint64_t carry = _addcarry_u64(0, data[0], scalar, (unsigned long long*)&data[0]);
+        for (int i = 1; i < NUM_WORDS; ++i)
+        {
+            carry = _addcarry_u64(carry, data[i], 0, (unsigned long long*)&data[i]);
+        }
+#else
+        uint64_t carry = static_cast<uint64_t>(scalar);
+
+        for (int i = 0; i < NUM_WORDS && carry != 0; ++i)
+        {
+            // Add carry to the current word and compute the new carry
+            uint64_t sum = static_cast<uint64_t>(data[i]) + carry;
+            data[i] = static_cast<uint64_t>(sum);
+            carry = (sum < carry) ? 1 : 0; // Carry occurs if overflow happened
+        }
+#endif
+        return *this;
+    }
+
+    QBigNum& operator-=(int64_t scalar)
+    {
+        if (scalar == 0)
+        {
+            return *this; // No operation needed for zero
+        }
+
+        if (scalar < 0)
+        {
+            // Subtracting a negative is equivalent to addition
+            *this += static_cast<uint64_t>(-scalar);
+            return *this;
+        }
+
+#if defined(HAS_ADCINTRIN)
+        uint64_t borrow = _subborrow_u64(0, data[0], scalar, (unsigned long long*)&data[0]);
+        for (int i = 1; i < NUM_WORDS; ++i)
+        {
+            borrow = _subborrow_u64(borrow, data[i], 0, (unsigned long long*)&data[i]);
+        }
+#else
+        uint64_t borrow = static_cast<uint64_t>(scalar);
+        for (int i = 0; i < NUM_WORDS; ++i)
+        {
+            uint64_t current = static_cast<uint64_t>(data[i]);
+            uint64_t diff = current - borrow;
+            data[i] = static_cast<uint64_t>(diff);
+            borrow = (current < borrow) ? 1 : 0;
+        }
+#endif
+
+        return *this;
+    }
+
+    /* QBigNum operations */
+
+    QPair<QBigNum, QBigNum> operator/(const QBigNum& divisor) const
+    {
+        QBigNum q;
+        QBigNum r;
+        QBigNum n = abs(*this);
+        QBigNum d = abs(divisor);
+
+        bool nflag = isNegative() != divisor.isNegative();
+
+        int nn = QBigNumKernels::normalizedSize(n.data.data(), NUM_WORDS);
+        int dn = QBigNumKernels::normalizedSize(d.data.data(), NUM_WORDS);
+        if (dn == 0)
+        {
+            throw std::overflow_error("Division by zero");
+        }
+
+        /* Magnitudes, abs(min()) is still 2^(Bits - 1) when read unsigned */
+        if (nn < dn)
+        {
+            r = n;
+        }
+        else
+        {
+            std::array<uint64_t, QBigNumKernels::divRemScratchSize(NUM_WORDS, NUM_WORDS)> scratch;
+            QBigNumKernels::divRem(q.data.data(), r.data.data(), n.data.data(), nn, d.data.data(), dn, scratch.data());
+        }
+
+        if (nflag)
+        {
+            q = -q;
+        }
+
+        /* Sign of r is dictated by divisor */
+        if (divisor.isNegative())
+        {
+            r = -r;
+        }
+
+        /* If signs don't match and there is a remainder */
+        if (divisor.isNegative() != isNegative() && r != 0)
+        {
+            q--;
+            r = divisor - r;
+        }
+
+        /* should be r = dividend - q * divisor */
+
+        return QPair<QBigNum, QBigNum>(q, r);
+    }
+
+    /* Divides in place by a single word with floor semantics and returns the remainder, which is never -ve.
+       Powers of two are an arithmetic shift and a mask */
+    uint64_t divmod1(uint64_t divisor)
+    {
+        if (divisor == 0)
+        {
+            throw std::overflow_error("Division by zero");
+        }
+
+        bool negative = isNegative();
+        if ((divisor & (divisor - 1)) == 0)
+        {
+            uint64_t remainder = data[0] & (divisor - 1);
+            int shift = __builtin_ctzll(divisor);
+            /* floor(n / 2^k) is ~(~n >> k) for -ve n */
+            if (negative)
+            {
+                for (auto& word : data)
+                {
+                    word = ~word;
+                }
+            }
+            *this >>= shift;
+            if (negative)
+            {
+                for (auto& word : data)
+                {
+                    word = ~word;
+                }
+            }
+            return remainder;
+        }
+
+        if (negative)
+        {
+            QBigNumKernels::negate(data.data(), NUM_WORDS);
+        }
+        int n = QBigNumKernels::normalizedSize(data.data(), NUM_WORDS);
+        uint64_t remainder = QBigNumKernels::divRem1(data.data(), data.data(), n, divisor);
+        if (negative)
+        {
+            if (remainder != 0)
+            {
+                ++*this;
+                remainder = divisor - remainder;
+            }
+            QBigNumKernels::negate(data.data(), NUM_WORDS);
+        }
+        return remainder;
+    }
+
+    /* Remainder of a single word divisor with floor semantics, never -ve */
+    uint64_t mod1(uint64_t divisor) const
+    {
+        if (divisor == 0)
+        {
+            throw std::overflow_error("Division by zero");
+        }
+        if ((divisor & (divisor - 1)) == 0)
+        {
+            return data[0] & (divisor - 1);
+        }
+
+        if (isNegative())
+        {
+            QBigNum magnitude = -*this;
+            int n = QBigNumKernels::normalizedSize(magnitude.data.data(), NUM_WORDS);
+            uint64_t remainder = QBigNumKernels::mod1(magnitude.data.data(), n, divisor);
+            return (remainder == 0) ? 0 : divisor - remainder;
+        }
+        return QBigNumKernels::mod1(data.data(), QBigNumKernels::normalizedSize(data.data(), NUM_WORDS), divisor);
+    }
+
+    QPair<QBigNum, QBigNum> operator/(int64_t scalar) const
+    {
+        QBigNum q = *this;
+        int64_t r = q.divModScalar(scalar);
+        return QPair<QBigNum, QBigNum>(q, QBigNum(r));
+    }
+
+    QBigNum div(const QBigNum& divisor) const
+    {
+        auto [quotient, remainder] = *this / divisor;
+        return quotient;
+    }
+
+    QBigNum div(int64_t divisor) const
+    {
+        QBigNum q = *this;
+        q.divModScalar(divisor);
+        return q;
+    }
+
+    static QBigNum div(QBigNum dividend, QBigNum divisor)
+    {
+        auto [quotient, remainder] = dividend / divisor;
+        return quotient;
+    }
+
+    static QBigNum div(const QString& dividend, const QString& divisor)
+    {
+        auto [quotient, remainder] = QBigNum(dividend) / QBigNum(divisor);
+        return quotient;
+    }
+
+    constexpr QBigNum& operator|=(uint64_t scalar)
+    {
+        data[0] |= scalar;
+        return *this;
+    }
+
+    constexpr QBigNum& operator&=(uint64_t scalar)
+    {
+        data[0] &= scalar;
+        return *this;
+    }
+
+    constexpr static QBigNum abs(const QBigNum& num)
+    {
+        QBigNum result = num;
+        if (result.isNegative())
+        {
+            return -result;
+        }
+        return result;
+    }
+
+    static QBigNum abs(const QString& num)
+    {
+        return QBigNum::abs(QBigNum(num));
+    }
+
+    /* 1 for a quadratic residue, -1 for a non residue and 0 when p divides a. p must be an odd prime, for
+       composite p this is the Jacobi symbol, which can be 1 for a non residue */
+    static int legendre(const QBigNum& a, const QBigNum& p)
+    {
+        return QBigNum::jacobi(a, p);
+    }
+
+    static int legendre(const QString& a, const QString& p)
+    {
+        return QBigNum::legendre(QBigNum(a), QBigNum(p));
+    }
+
+    static int legendre(int64_t a, int64_t p)
+    {
+        return QBigNum::legendre(QBigNum(a), QBigNum(p));
+    }
+
+    /* prime number test */
+    static bool millerRabin(const QBigNum& n, int k = 44)
+    {
+        if (n <= 1)
+        {
+            return false;
+        }
+        if (n == 2 || n == 3)
+        {
+            return true; // n is prime
+        }
+        if (n % 2 == 0)
+        {
+            return false; // Even numbers > 2 are not prime
+        }
+
+        // Small prime divisors check
+        std::vector<int> smallPrimes = {5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47, 53, 59, 61, 67, 71, 73, 79, 83, 89, 97};
+        for (int prime : smallPrimes)
+        {
+            QBigNum primeBN = QBigNum(prime);
+            if (n % primeBN == 0 && n != primeBN)
+            {
+                return false;
+            }
+        }
+
+        // Write n - 1 as d * 2^r
+        QBigNum d = n - 1;
+        int r = 0;
+        while (d % 2 == 0)
+        {
+            d /= 2;
+            r++;
+        }
+
+        // n is odd, so every round can stay in Montgomery form and compare against the forms of 1 and n - 1
+        QBigNumMontgomery<Bits> mont(n);
+        QBigNum one = mont.toMont(1);
+        QBigNum minusOne = mont.toMont(n - 1);
+
+        // Perform k iterations of the test
+        for (int i = 0; i < k; ++i)
+        {
+            // Generate random a in range [2, n - 2]
+            QBigNum a = QBigNum::randomInRange(2, n - 2);
+
+            // Compute x = a^d % n
+            QBigNum x = mont.pow(mont.toMont(a), d);
+
+            if (x == one || x == minusOne)
+            {
+                continue;
+            }
+
+            bool isComposite = true;
+            for (int j = 0; j < r - 1; ++j)
+            {
+                x = mont.sqr(x);
+                if (x == minusOne)
+                {
+                    isComposite = false;
+                    break;
+                }
+            }
+
+            if (isComposite)
+            {
+                return false;
+            }
+        }
+
+        return true; // n is probably prime
+    }
+
+    static bool millerRabin(const QString& n, int k = 44)
+    {
+        return QBigNum::millerRabin(QBigNum(n), k);
+    }
+
+    static bool millerRabin(int64_t n, int k = 44)
+    {
+        return QBigNum::millerRabin(QBigNum(n), k);
+    }
+
+    /* generalization of legendre but for compisitte numbers so no use for tonelli. Even and negative n give the
+       Kronecker symbol. Twos come off n with a trailing zero count and a mod 8 lookup on the low word of a, the odd
+       part goes to the batched binary jacobiOdd, which needs no division unless the lengths are far apart */
+    static int jacobi(const QBigNum& a, const QBigNum& n)
+    {
+        if (n == 0)
+        {
+            return (a == 1 || a == -1) ? 1 : 0;
+        }
+
+        int result = 1;
+        QBigNum m = QBigNum::abs(n);
+        if (n.isNegative() && a.isNegative())
+        {
+            result = -result; // (a/-1) is -1 for negative a
+        }
+
+        int zeros = QBigNumKernels::trailingZeros(m.data.data(), NUM_WORDS(Bits));
+        if (zeros > 0)
+        {
+            if ((a.data[0] & 1) == 0)
+            {
+                return 0;
+            }
+            if (zeros & int((a.data[0] >> 1) ^ (a.data[0] >> 2)) & 1)
+            {
+                result = -result; // (a/2) is -1 for a = 3 or 5 mod 8
+            }
+            m >>= zeros;
+        }
+
+        QBigNum g = QBigNum::abs(a);
+        if (a.isNegative() && (m.data[0] & 3) == 3)
+        {
+            result = -result; // (-1/m) is -1 for m = 3 mod 4
+        }
+
+        /* Posdivsteps shrink the larger number slowly when the sizes are far apart, so one reduction levels them */
+        if (g != 0 && g.bitLength() > m.bitLength() + 64)
+        {
+            g %= m;
+        }
+        else if (g != 0 && g.bitLength() + 64 < m.bitLength())
+        {
+            int gZeros = QBigNumKernels::trailingZeros(g.data.data(), NUM_WORDS(Bits));
+            if (gZeros & int((m.data[0] >> 1) ^ (m.data[0] >> 2)) & 1)
+            {
+                result = -result; // (2/m) as above
+            }
+            g >>= gZeros;
+            if (g.data[0] & m.data[0] & 2)
+            {
+                result = -result; // Reciprocity for g and m both 3 mod 4
+            }
+            std::swap(g, m);
+            g %= m;
+        }
+
+        std::array<uint64_t, NUM_WORDS(Bits) + 1> u{};
+        std::array<uint64_t, NUM_WORDS(Bits) + 1> v{};
+        std::array<uint64_t, NUM_WORDS(Bits) + 1> t;
+        std::copy(m.data.begin(), m.data.end(), u.begin());
+        std::copy(g.data.begin(), g.data.end(), v.begin());
+        return result * QBigNumKernels::jacobiOdd(u.data(), v.data(), NUM_WORDS(Bits), t.data());
+    }
+
+    static int jacobi(const QString& a, const QString& n)
+    {
+        return QBigNum::jacobi(QBigNum(a), QBigNum(n));
+    }
+
+    static int jacobi(int64_t a, int64_t n)
+    {
+        return QBigNum::jacobi(QBigNum(a), QBigNum(n));
+    }
+
+    /* p needs to be prime for this algo wil find quadratic residuals */
+    static QBigNum tonelli(const QBigNum& n, const QBigNum& p)
+    {
+        if (n == 1 || n == 0)
+        {
+            return n;
+        }
+
+        if (legendre(n, p) != 1)
+        {
+            throw std::invalid_argument("Not a square (mod p)");
+        }
+
+        static QBigNum p_last;
+        static bool p_last_is_prime = false;
+
+        if (p != p_last)
+        {
+            p_last = p;
+            p_last_is_prime = QBigNum::millerRabin(p_last);
+        }
+
+        if (!p_last_is_prime)
+        {
+            throw std::invalid_argument("p isn't prime");
+        }
+
+        QBigNum q = p - 1;
+        uint s = 0;
+
+        // Factorize p - 1 as q * 2^s
+        while ((q % 2) == 0)
+        {
+            q /= 2;
+            s++;
+        }
+
+        if (s == 1)
+        {
+            return QBigNum::powMod(n, (p + 1).div(4), p);
+        }
+
+        // Find a non-residue z
+        QBigNum z = 2;
+        while (legendre(z, p) != -1)
+        {
+            z++;
+        }
+
+        QBigNum c = QBigNum::powMod(z, q, p);
+        QBigNum r = QBigNum::powMod(n, (q + 1).div(2), p);
+        QBigNum t = QBigNum::powMod(n, q, p);
+        uint m = s;
+
+        while ((t - 1) % p != 0)
+        {
+            QBigNum t2 = t;
+            uint i = 0;
+
+            for (i = 1; i < m; ++i)
+            {
+                t2 = QBigNum::sqrMod(t2, p);
+                if ((t2 - 1) % p == 0)
+                {
+                    break;
+                }
+            }
+
+            QBigNum b = QBigNum::powMod(c, QBigNum(1) << (m - i - 1), p);
+            r = QBigNum::mulMod(r, b, p);
+            c = QBigNum::sqrMod(b, p);
+            t = QBigNum::mulMod(t, c, p);
+            m = i;
+        }
+
+        return r;
+    }
+
+    static QBigNum tonelli(const QString& n, const QString& p)
+    {
+        return QBigNum::tonelli(QBigNum(n), QBigNum(p));
+    }
+
+    static QBigNum tonelli(int64_t n, int64_t p)
+    {
+        return QBigNum::tonelli(QBigNum(n), QBigNum(p));
+    }
+
+    /* Fused multiply-accumulate. Like operator*= these wrap modulo 2^Bits so they work for -ve numbers too */
+
+    // a += b * c in one pass per limb of c without building the product
+    static void addMul(QBigNum& a, const QBigNum& b, const QBigNum& c)
+    {
+        for (int i = 0; i < NUM_WORDS; ++i)
+        {
+            QBigNumKernels::addMul1(&a.data[i], b.data.data(), NUM_WORDS - i, c.data[i]);
+        }
+    }
+
+    // a -= b * c in one pass per limb of c without building the product
+    static void subMul(QBigNum& a, const QBigNum& b, const QBigNum& c)
+    {
+        for (int i = 0; i < NUM_WORDS; ++i)
+        {
+            QBigNumKernels::subMul1(&a.data[i], b.data.data(), NUM_WORDS - i, c.data[i]);
+        }
+    }
+
+    // a += b * c for a single limb c
+    static void addMul1(QBigNum& a, const QBigNum& b, uint64_t c)
+    {
+        QBigNumKernels::addMul1(a.data.data(), b.data.data(), NUM_WORDS, c);
+    }
+
+    // a -= b * c for a single limb c
+    static void subMul1(QBigNum& a, const QBigNum& b, uint64_t c)
+    {
+        QBigNumKernels::subMul1(a.data.data(), b.data.data(), NUM_WORDS, c);
+    }
+
+    /* Doesn't check for overflow */
+    QBigNum& operator*=(const QBigNum& other)
+    {
+        QBigNum result;
+        QBigNum ua = abs(*this);
+        QBigNum ub = abs(other);
+        int na = QBigNumKernels::normalizedSize(ua.data.data(), NUM_WORDS);
+        int nb = QBigNumKernels::normalizedSize(ub.data.data(), NUM_WORDS);
+
+        if (qMin(na, nb) < mulThresholds.karatsuba)
+        {
+            QBigNumKernels::mulLow(result.data.data(), NUM_WORDS, ua.data.data(), na, ub.data.data(), nb);
+        }
+        else
+        {
+            /* Karatsuba, Toom-3 and the NTT have no truncated form, take the low words of the full product */
+            std::array<uint64_t, 2 * NUM_WORDS> product{};
+            mulMagnitudes(product.data(), ua.data.data(), na, ub.data.data(), nb);
+            std::copy(product.begin(), product.begin() + NUM_WORDS, result.data.begin());
+        }
+
+        if (isNegative() != other.isNegative())
+        {
+            result = -result;
+        }
+        *this = result;
+        return *this;  // Return the modified object
+    }
+
+    /* Full product that can't overflow */
+    static QBigNum<2 * Bits> mulWide(const QBigNum& a, const QBigNum& b)
+    {
+        std::array<uint64_t, 2 * NUM_WORDS> product;
+        mulFull(product, a, b);
+
+        QBigNum<2 * Bits> result;
+        std::copy(product.begin(), product.begin() + QBigNum<2 * Bits>::NUM_WORDS, result.data.begin());
+        return result;
+    }
+
+    /* Full square, about half the limb multiplies of mulWide(a, a) */
+    static QBigNum<2 * Bits> sqrWide(const QBigNum& a)
+    {
+        QBigNum ua = abs(a);
+        int na = QBigNumKernels::normalizedSize(ua.data.data(), NUM_WORDS);
+        std::array<uint64_t, 2 * NUM_WORDS> product{};
+        sqrMagnitude(product.data(), ua.data.data(), na);
+
+        QBigNum<2 * Bits> result;
+        std::copy(product.begin(), product.begin() + QBigNum<2 * Bits>::NUM_WORDS, result.data.begin());
+        return result;
+    }
+
+    /* Upper NUM_WORDS words of the full product, i.e. floor(a * b / 2^(64 * NUM_WORDS)) */
+    static QBigNum mulHigh(const QBigNum& a, const QBigNum& b)
+    {
+        std::array<uint64_t, 2 * NUM_WORDS> product;
+        mulFull(product, a, b);
+
+        QBigNum result;
+        std::copy(product.begin() + NUM_WORDS, product.end(), result.data.begin());
+        return result;
+    }
+
+    QBigNum& operator-=(const QBigNum& other)
+    {
+        QBigNumKernels::subFixed<NUM_WORDS>(data.data(), other.data.data());
+        return *this;
+    }
+
+    QBigNum& operator+=(const QBigNum& other)
+    {
+        QBigNumKernels::addFixed<NUM_WORDS>(data.data(), other.data.data());
+        return *this;
+    }
+
+    QBigNum& operator++()
+    {
+        for (int i = 0; i < NUM_WORDS; ++i)
+        {
+            if (++data[i] != 0)
+            {
+                break; // No carry needed
+            }
+        }
+        return *this;
+    }
+
+    QBigNum& operator--()
+    {
+        for (int i = 0; i < NUM_WORDS; ++i)
+        {
+            if (data[i]-- != 0)
+            {
+                break; // No borrow needed
+            }
+        }
+        return *this;
+    }
+
+    static QBigNum mulMod(const QBigNum& a, const QBigNum& b, const QBigNum& m)
+    {
+        return reduceWide(mulWide(a, b), m);
+    }
+
+    static QBigNum sqrMod(const QBigNum& a, const QBigNum& m)
+    {
+        return reduceWide(sqrWide(a), m);
+    }
+
+    /* Overloads for a precomputed reducer such as QBigNumBarrett, which already knows the modulus */
+    template <typename Reducer, typename = std::enable_if_t<Reducer::IsQBigNumReducer>>
+    static QBigNum mulMod(const QBigNum& a, const QBigNum& b, const Reducer& reducer)
+    {
+        return reducer.mulMod(a, b);
+    }
+
+    template <typename Reducer, typename = std::enable_if_t<Reducer::IsQBigNumReducer>>
+    static QBigNum sqrMod(const QBigNum& a, const Reducer& reducer)
+    {
+        return reducer.sqrMod(a);
+    }
+
+    static QBigNum mulMod(const QString& a, const QString& b, const QString& m)
+    {
+        return QBigNum::mulMod(QBigNum(a), QBigNum(b), QBigNum(m));
+    }
+
+    static QBigNum mulMod(int64_t a, int64_t b, int64_t m)
+    {
+        return QBigNum::mulMod(QBigNum(a), QBigNum(b), QBigNum(m));
+    }
+
+    // Non-const version: allows modification of data
+    uint64_t& operator[](size_t index)
+    {
+        if (index >= NUM_WORDS)
+        {
+            throw std::out_of_range("Index out of range");
+        }
+        return data[index];
+    }
+
+    // Const version: read-only access
+    const uint64_t& operator[](size_t index) const
+    {
+        if (index >= NUM_WORDS)
+        {
+            throw std::out_of_range("Index out of range");
+        }
+        return data[index];
+    }
+
+    static QBigNum powMod(const QBigNum& base, const QBigNum& exp, const QBigNum& mod)
+    {
+        QBigNum result = base.powMod(exp, mod);
+        return result;
+    }
+
+    template <typename Reducer, typename = std::enable_if_t<Reducer::IsQBigNumReducer>>
+    static QBigNum powMod(const QBigNum& base, const QBigNum& exp, const Reducer& reducer)
+    {
+        return reducer.powMod(base, exp);
+    }
+
+    static QBigNum powMod(const QString& base, const QString& exp, const QString& mod)
+    {
+        QBigNum result = QBigNum(base).powMod(QBigNum(exp), QBigNum(mod));
+        return result;
+    }
+
+    static QBigNum powMod(int64_t base, int64_t exp, const int64_t mod)
+    {
+        QBigNum result = QBigNum(base).powMod(QBigNum(exp), QBigNum(mod));
+        return result;
+    }
+
+    /* prod bases[i]^exps[i] mod mod, e.g. g^a h^b, sharing the squarings between all the bases. -ve exponents
+       invert their base first */
+    static QBigNum multiPowMod(const QList<QBigNum>& bases, const QList<QBigNum>& exps, const QBigNum& mod)
+    {
+        if (mod == 0)
+        {
+            throw std::invalid_argument("Modulus cannot be zero.");
+        }
+        if (bases.size() != exps.size())
+        {
+            throw std::invalid_argument("Need one exponent per base.");
+        }
+
+        std::vector<QBigNum> a;
+        std::vector<QBigNum> e;
+        for (int i = 0; i < bases.size(); ++i)
+        {
+            bool invert = exps[i] < 0;
+            a.push_back(invert ? bases[i].inverseMod(mod) : bases[i]);
+            e.push_back(invert ? -exps[i] : exps[i]);
+        }
+
+        if (mod > 0 && (mod.data[0] & 1))
+        {
+            QBigNumMontgomery<Bits> mont(mod);
+            for (QBigNum& x : a)
+            {
+                x = mont.toMont(x);
+            }
+            return mont.fromMont(multiWindowedPow(a, e, mont.toMont(1),
+                                                  [&mont](const QBigNum& x, const QBigNum& y) { return mont.mul(x, y); },
+                                                  [&mont](const QBigNum& x) { return mont.sqr(x); }));
+        }
+        if (mod > 0)
+        {
+            QBigNumBarrett<Bits> barrett(mod);
+            for (QBigNum& x : a)
+            {
+                x = barrett.reduce(x);
+            }
+            return multiWindowedPow(a, e, barrett.reduce(QBigNum(1)),
+                                    [&barrett](const QBigNum& x, const QBigNum& y) { return barrett.mulMod(x, y); },
+                                    [&barrett](const QBigNum& x) { return barrett.sqrMod(x); });
+        }
+        for (QBigNum& x : a)
+        {
+            x %= mod;
+        }
+        return multiWindowedPow(a, e, QBigNum(1) % mod,
+                                [&mod](const QBigNum& x, const QBigNum& y) { return mulMod(x, y, mod); },
+                                [&mod](const QBigNum& x) { return sqrMod(x, mod); });
+    }
+
+    QBigNum powMod(const QBigNum& exp, const QBigNum& mod) const
+    {
+        if (mod == 0)
+        {
+            throw std::invalid_argument("Modulus cannot be zero.");
+        }
+
+        if (mod > 0)
+        {
+            /* Converting in and out of Montgomery form costs a couple of divisions, worth it past a few squarings */
+            if ((mod.data[0] & 1) && exp.bitLength() >= QBIGNUM_MONTGOMERY_THRESHOLD)
+            {
+                return QBigNumMontgomery<Bits>(mod).powMod(*this, exp);
+            }
+            return QBigNumBarrett<Bits>(mod).powMod(*this, exp);
+        }
+
+        if (exp < 0)
+        {
+            QBigNum base_inv = inverseMod(mod);
+            return powMod(base_inv, -exp, mod);
+        }
+
+        /* -ve modulus, no precomputed reducer so every step divides. Seeding with 1 % mod keeps exp == 0 reduced
+           like the +ve path */
+        return windowedPow(*this % mod, exp, QBigNum(1) % mod,
+                           [&mod](const QBigNum& x, const QBigNum& y) { return mulMod(x, y, mod); },
+                           [&mod](const QBigNum& x) { return sqrMod(x, mod); });
+    }
+
+    /* Odd moduli take the division free binary gcd, even ones fall back to extended Euclid */
+    QBigNum inverseMod(const QBigNum& mod) const
+    {
+        if (mod == 0)
+        {
+            throw std::invalid_argument("Modulus cannot be zero.");
+        }
+
+        if (mod < 0)
+        {
+            QBigNum result = inverseMod(-mod) + mod;
+            return result;
+        }
+
+        if (mod == 1)
+        {
+            return 0;
+        }
+
+        QBigNum a = *this % mod; // Reduce `this` modulo `mod`
+        if ((mod.data[0] & 1) == 0)
+        {
+            return inverseModEuclid(a, mod);
+        }
+
+        int n = QBigNumKernels::normalizedSize(mod.data.data(), NUM_WORDS(Bits));
+        std::array<uint64_t, NUM_WORDS(Bits) + 1> r;
+        std::array<uint64_t, 4 * (NUM_WORDS(Bits) + 1)> t;
+        bool invertible = usesHalfGcd(a.data.data(), mod.data.data(), hgcdInverseThreshold)
+                              ? QBigNumKernels::HalfGcd::inverse(r.data(), a.data.data(), mod.data.data(), n, t.data(), hgcdInverseThreshold, mulThresholds)
+                              : QBigNumKernels::inverseOdd(r.data(), a.data.data(), mod.data.data(), n, t.data());
+        if (!invertible)
+        {
+            throw std::invalid_argument("Inverse does not exist.");
+        }
+
+        QBigNum result;
+        std::copy(r.begin(), r.begin() + n, result.data.begin());
+        return result;
+    }
+
+    /* values[i] = values[i]^-1 mod mod in place by Montgomery's trick, one inverseMod and 3(n - 1) multiplies.
+       Entries divisible by mod come back 0 and stay out of the running product. If any other entry has no
+       inverse this throws, naming the first such entry, and values is left as it was */
+    static void batchInverseMod(QList<QBigNum>& values, const QBigNum& mod)
+    {
+        if (mod == 0)
+        {
+            throw std::invalid_argument("Modulus cannot be zero.");
+        }
+
+        QBigNumBarrett<Bits> barrett(QBigNum::abs(mod));
+
+        /* prefix[i] is the product of the non zero residues before i */
+        std::vector<QBigNum> residues(values.size());
+        std::vector<QBigNum> prefix(values.size());
+        QBigNum product;
+        int first = -1;
+        for (int i = 0; i < values.size(); ++i)
+        {
+            residues[i] = barrett.reduce(values[i]);
+            if (residues[i] == 0)
+            {
+                continue;
+            }
+            prefix[i] = product;
+            product = (first < 0) ? residues[i] : barrett.mulMod(product, residues[i]);
+            first = (first < 0) ? i : first;
+        }
+
+        /* Only a failed inverse pays for finding the culprit */
+        QBigNum inverse;
+        try
+        {
+            inverse = (first < 0) ? inverse : product.inverseMod(barrett.modulus());
+        }
+        catch (const std::invalid_argument&)
+        {
+            for (int i = 0; i < values.size(); ++i)
+            {
+                if (residues[i] != 0 && gcd(residues[i], barrett.modulus()) != 1)
+                {
+                    throw std::invalid_argument("Inverse does not exist for entry " + std::to_string(i) + ".");
+                }
+            }
+            throw;
+        }
+
+        /* Walking back, inverse is the inverse of the product of the non zero residues up to i */
+        for (int i = values.size() - 1; i > first; --i)
+        {
+            if (residues[i] == 0)
+            {
+                continue;
+            }
+            QBigNum value = residues[i];
+            residues[i] = barrett.mulMod(inverse, prefix[i]);
+            inverse = barrett.mulMod(inverse, value);
+        }
+        if (first >= 0)
+        {
+            residues[first] = inverse;
+        }
+
+        for (int i = 0; i < values.size(); ++i)
+        {
+            values[i] = (mod < 0 && residues[i] != 0) ? residues[i] + mod : residues[i];
+        }
+    }
+
+    /* Common factors of 2 come off whole words at a time, the odd parts go to the batched binary gcd */
+    static QBigNum gcd(QBigNum a, QBigNum b)
+    {
+        if (a == 0)
+        {
+            return b;
+        }
+        if (b == 0)
+        {
+            return a;
+        }
+
+        a = QBigNum::abs(a);
+        b = QBigNum::abs(b);
+        int aZeros = QBigNumKernels::trailingZeros(a.data.data(), NUM_WORDS(Bits));
+        int bZeros = QBigNumKernels::trailingZeros(b.data.data(), NUM_WORDS(Bits));
+        a >>= aZeros;
+        b >>= bZeros;
+
+        std::array<uint64_t, NUM_WORDS(Bits) + 1> u{};
+        std::array<uint64_t, NUM_WORDS(Bits) + 1> v{};
+        std::array<uint64_t, NUM_WORDS(Bits) + 1> t;
+        std::copy(a.data.begin(), a.data.end(), u.begin());
+        std::copy(b.data.begin(), b.data.end(), v.begin());
+        if (usesHalfGcd(u.data(), v.data(), hgcdThreshold))
+        {
+            QBigNumKernels::HalfGcd::gcd(u.data(), v.data(), NUM_WORDS(Bits), t.data(), hgcdThreshold, mulThresholds);
+        }
+        else
+        {
+            QBigNumKernels::gcdOdd(u.data(), v.data(), NUM_WORDS(Bits), t.data());
+        }
+
+        QBigNum result;
+        std::copy(v.begin(), v.begin() + NUM_WORDS(Bits), result.data.begin());
+        return result << qMin(aZeros, bZeros);
+    }
+
+    static QBigNum gcd(const QString& a, const QString& b)
+    {
+        return gcd(QBigNum(a), QBigNum(b));
+    }
+
+    static QBigNum gcd(int64_t a, int64_t b)
+    {
+        return gcd(QBigNum(a), QBigNum(b));
+    }
+
+    static QBigNum gcd_slow(QBigNum a, QBigNum b)
+    {
+        if (a == 0)
+        {
+            return b;
+        }
+        if (b == 0)
+        {
+            return a;
+        }
+        a = QBigNum::abs(a);
+        b = QBigNum::abs(b);
+        while (b != 0 && a != 0)
+        {
+            if (b < a)
+            {
+                a %= b;
+            }
+            else
+            {
+                b %= a;
+            }
+        }
+        if (a == 0)
+        {
+            return b;
+        }
+        return a;
+    }
+
+    static QBigNum gcd_slow(const QString& a, const QString& b)
+    {
+        return gcd_slow(QBigNum(a), QBigNum(b));
+    }
+
+    static QBigNum gcd_slow(int64_t a, int64_t b)
+    {
+        return gcd_slow(QBigNum(a), QBigNum(b));
+    }
+
+    /* Friends */
+
+    friend QBigNum operator-(int64_t lhs, const QBigNum& rhs)
+    {
+        return QBigNum(lhs) - rhs;
+    }
+
+    friend QBigNum operator+(int64_t lhs, const QBigNum& rhs)
+    {
+        return QBigNum(lhs) + rhs;
+    }
+
+    friend QBigNum operator*(int64_t lhs, const QBigNum& rhs)
+    {
+        return QBigNum(lhs) * rhs;
+    }
+
+    friend QBigNum operator%(int64_t lhs, const QBigNum& rhs)
+    {
+        return QBigNum(lhs) % rhs;
+    }
+
+    /* Hany operations */
+
+    constexpr QBigNum operator-() const
+    {
+        return this->twosComplement();
+    }
+
+    constexpr QBigNum operator<<(int bits) const
+    {
+        QBigNum result = *this;
+        result <<= bits;
+        return result;
+    }
+
+    constexpr QBigNum operator>>(int bits) const
+    {
+        QBigNum result = *this;
+        result >>= bits;
+        return result;
+    }
+
+    QBigNum operator+(int64_t scalar) const
+    {
+        QBigNum result = *this;
+        result += scalar;
+        return result;
+    }
+
+    QBigNum operator-(int64_t scalar) const
+    {
+        QBigNum result = *this;
+        result -= scalar;
+        return result;
+    }
+
+    constexpr QBigNum operator*(int64_t scalar) const
+    {
+        QBigNum result = *this;
+        result *= scalar;
+        return result;
+    }
+
+    QBigNum operator+(const QBigNum& other) const
+    {
+        QBigNum result = *this;
+        result += other;
+        return result;
+    }
+
+    QBigNum operator-(const QBigNum& other) const
+    {
+        QBigNum result = *this;
+        result -= other;
+        return result;
+    }
+
+    QBigNum& operator/=(const QBigNum& divisor)
+    {
+        auto [quotient, remainder] = *this / divisor;
+        *this = quotient;
+        return *this;
+    }
+
+    QBigNum operator++(int)
+    {
+        QBigNum temp = *this;
+        ++(*this); // Use pre-increment
+        return temp;
+    }
+
+    QBigNum operator--(int)
+    {
+        QBigNum temp = *this;
+        --(*this); // Use pre-decrement
+        return temp;
+    }
+
+    /* Same sign rules as operator/ but reduces in place and never forms the quotient */
+    QBigNum& operator%=(const QBigNum& divisor)
+    {
+        bool negative = isNegative();
+        bool divisorNegative = divisor.isNegative();
+
+        /* Only copy the divisor when its magnitude differs from its words or it is *this */
+        QBigNum d;
+        const uint64_t* dp = divisor.data.data();
+        if (divisorNegative || &divisor == this)
+        {
+            d = abs(divisor);
+            dp = d.data.data();
+        }
+        int dn = QBigNumKernels::normalizedSize(dp, NUM_WORDS);
+        if (dn == 0)
+        {
+            throw std::overflow_error("Division by zero");
+        }
+
+        if (negative)
+        {
+            QBigNumKernels::negate(data.data(), NUM_WORDS);
+        }
+        int nn = QBigNumKernels::normalizedSize(data.data(), NUM_WORDS);
+        if (nn >= dn)
+        {
+            std::array<uint64_t, QBigNumKernels::divRemScratchSize(NUM_WORDS, NUM_WORDS)> scratch;
+            QBigNumKernels::mod(data.data(), data.data(), nn, dp, dn, scratch.data());
+            std::fill(data.begin() + dn, data.end(), 0);
+        }
+
+        /* Floor semantics, a remainder against a divisor of the other sign is |d| - r */
+        if (negative != divisorNegative && QBigNumKernels::normalizedSize(data.data(), dn) != 0)
+        {
+            QBigNumKernels::sub(data.data(), dp, data.data(), dn);
+        }
+        if (divisorNegative)
+        {
+            QBigNumKernels::negate(data.data(), NUM_WORDS);
+        }
+        return *this;
+    }
+
+    QBigNum operator%(const QBigNum& divisor) const
+    {
+        QBigNum remainder = *this;
+        remainder %= divisor;
+        return remainder;
+    }
+
+    QBigNum operator*(const QBigNum& other) const
+    {
+        QBigNum result = *this;
+        result *= other;
+        return result;
+    }
+
+    QBigNum& operator%=(int64_t scalar)
+    {
+        *this = QBigNum(modScalar(scalar));
+        return *this;
+    }
+
+    QBigNum& operator/=(int64_t scalar)
+    {
+        divModScalar(scalar);
+        return *this;
+    }
+
+    QBigNum operator%(int64_t scalar) const
+    {
+        return QBigNum(modScalar(scalar));
+    }
+
+    /* Comparisons. */
+
+    bool operator==(const QString &decimalStr) const
+    {
+        QBigNum other = decimalStr;
+        return *this == other;
+    }
+
+    constexpr bool operator==(int64_t scalar) const
+    {
+        QBigNum other = QBigNum(scalar);
+        return *this == other;
+    }
+
+    constexpr bool operator<(int64_t scalar) const
+    {
+        QBigNum other = QBigNum(scalar);
+        return *this < other;
+    }
+
+    constexpr bool operator>(int64_t scalar) const
+    {
+        QBigNum other = QBigNum(scalar);
+        return *this > other;
+    }
+
+    constexpr bool operator<=(int64_t scalar) const
+    {
+        QBigNum other = QBigNum(scalar);
+        return *this <= other;
+    }
+
+    constexpr bool operator>=(int64_t scalar) const
+    {
+        QBigNum other = QBigNum(scalar);
+        return *this >= other;
+    }
+
+    constexpr bool operator>=(const QBigNum& other) const
+    {
+        // Handle sign mismatch
+        if (isNegative() != other.isNegative())
+        {
+            return !isNegative();
+        }
+        return QBigNumKernels::compareFixed<NUM_WORDS>(data.data(), other.data.data()) >= 0;
+    }
+
+    constexpr bool operator<=(const QBigNum& other) const
+    {
+        // Handle sign mismatch
+        if (isNegative() != other.isNegative())
+        {
+            return isNegative();
+        }
+        return QBigNumKernels::compareFixed<NUM_WORDS>(data.data(), other.data.data()) <= 0;
+    }
+
+    constexpr bool operator<(const QBigNum& other) const
+    {
+        return !(*this>=other);
+    }
+
+    constexpr bool operator>(const QBigNum& other) const
+    {
+        return !(*this<=other);
+    }
+
+    constexpr bool operator==(const QBigNum& other) const
+    {
+        return QBigNumKernels::equalFixed<NUM_WORDS>(data.data(), other.data.data());
+    }
+
+    constexpr bool operator!=(const QBigNum& other) const
+    {
+        return !(*this == other);
+    }
+
+    constexpr int compareAbs(const QBigNum& other) const
+    {
+        for (int i = NUM_WORDS - 1; i >= 0; i--)
+        {
+            uint64_t thisWord = isNegative() ? ~data[i] + (i == 0 ? 1 : 0) : data[i];
+            uint64_t otherWord = other.isNegative() ? ~other.data[i] + (i == 0 ? 1 : 0) : other.data[i];
+
+            if (thisWord != otherWord)
+            {
+                return (thisWord > otherWord) ? 1 : -1;
+            }
+        }
+        return 0; // Absolute values are equal
+    }
+
+    /* Conversion */
+
+    operator QString() const
+    {
+        return toDecimalString();
+    }
+
+    constexpr int64_t toInt64() const
+    {
+        return (int64_t)data[0];
+    }
+
+    template <size_t TargetBits>
+    QBigNum<TargetBits> convertTo() const
+    {
+        QBigNum<TargetBits> result;
+        size_t minWords = qMin(NUM_WORDS(Bits), NUM_WORDS(TargetBits));
+        for (size_t i = 0; i < minWords; ++i)
+        {
+            result[i] = this->data[i];
+        }
+        return result;
+    }
+
+    /* Misc */
+
+    // Static function to get the maximum value QBigNum can represent
+    static QBigNum max()
+    {
+        QBigNum maxVal;
+
+        maxVal.data.fill(UINT64_MAX);  // Fill all uint64_t words with 0xFFFFFFFFFFFFFFFF
+
+        // Set the sign bit (most significant bit) to 0
+        maxVal.data.back() &= ~(static_cast<uint64_t>(1) << 63);  // Clear the sign bit (MSB)
+
+        return maxVal;
+    }
+
+    // Static function to get the minimum value QBigNum can represent
+    static QBigNum min()
+    {
+        QBigNum minVal;
+
+        // The most negative value in two's complement has the highest bit set to 1 and all others set to 0
+        minVal.data.fill(0);
+        minVal.data.back() = static_cast<uint64_t>(1) << 63; // Set the sign bit (MSB) to 1
+
+        return minVal;
+    }
+
+    void debug(const QString &comment = QString()) const
+    {
+        if (comment.isEmpty())
+        {
+            qDebug() << toDecimalString();
+        }
+        else
+        {
+            qDebug() << comment << ":" << toDecimalString();
+        }
+    }
+
+    constexpr void setNegative(bool isNegative)
+    {
+        if (isNegative)
+        {
+            // Set the most significant bit (MSB) of the highest word
+            data[NUM_WORDS - 1] |= (1ULL << 63); // Assuming 64-bit words
+        }
+        else
+        {
+            // Clear the most significant bit (MSB) of the highest word
+            data[NUM_WORDS - 1] &= ~(1ULL << 63); // Assuming 64-bit words
+        }
+    }
+
+    constexpr QBigNum twosComplement() const
+    {
+        QBigNum num = *this;
+        __uint128_t carry = 1; // Start with the carry for adding 1
+        for (int i = 0; i < NUM_WORDS; ++i)
+        {
+            // Invert the bits of the current word and add the carry
+            __uint128_t temp = ~num.data[i] + carry;
+
+            // Store the lower 64 bits back into the current word
+            num.data[i] = static_cast<uint64_t>(temp);
+
+            // Compute the carry for the next word
+            carry = temp >> 64; // Extract the carry from the higher bits
+        }
+        return num;
+    }
+
+    constexpr int bitLength() const
+    {
+
+        // Handle negative numbers by considering their two's complement representation
+        if (isNegative())
+        {
+            // For negative numbers, calculate the bit length of the positive equivalent (ignoring the sign bit)
+            QBigNum<Bits> positiveNum = *this;
+            positiveNum = abs(positiveNum); // Get the absolute value
+            return positiveNum.bitLength();
+        }
+
+        for (int i = NUM_WORDS - 1; i >= 0; --i)
+        {
+            if (data[i] != 0)
+            {
+                 return (64 * i) + (64 - __builtin_clzll(data[i])) ;
+            }
+        }
+        return 0;
+    }
+
+    constexpr bool isNegative() const
+    {
+        return (data[NUM_WORDS - 1] >> 63);
+    }
+
+    QString toWordString() const
+    {
+        QString result;
+        for (int i = NUM_WORDS - 1; i >= 0; --i)
+        {
+            result += QString("0x%1 ").arg(data[i], 16, 16, QChar('0'));
+        }
+        result = result.trimmed();
+        return result;
+    }
+
+    QString toHexString() const
+    {
+        QString result;
+        QBigNum temp = *this;
+        if (temp.isNegative())
+        {
+            result += "-";
+            temp = -temp;
+        }
+        result += "0x";
+        bool isprinting = false;
+        for (int i = NUM_WORDS - 1; i >= 0; --i)
+        {
+            if (!isprinting && temp.data[i] == 0)
+            {
+                continue;
+            }
+            if (isprinting)
+            {
+                result += QString("%1").arg(temp.data[i], 16, 16, QChar('0'));
+            }
+            else
+            {
+                result += QString("%1").arg(temp.data[i], 0, 16, QChar('0'));
+            }
+            isprinting = true;
+        }
+        if (!isprinting)
+        {
+            result += "00";
+        }
+        return result;
+    }
+
+    QString toDecimalString() const
+    {
+        QString result;
+        QBigNum temp = *this; // Copy of the original number for manipulation
+
+        // Handle zero as a special case
+        if (temp == 0)
+        {
+            return "0";
+        }
+
+        temp = QBigNum::abs(temp);
+
+        // Convert the absolute value to a decimal string
+        while (temp > 0)
+        {
+            auto [quotient, remainder] = temp / 10;
+            temp = quotient;
+            result.prepend(QString::number(remainder[0]));
+        }
+
+        // Add the negative sign if necessary
+        if (isNegative())
+        {
+            result.prepend('-');
+        }
+
+        return result;
+    }
+
+    static QBigNum fromDecimal(const QString& decimalStr)
+    {
+        QBigNum result;
+        QString sanitizedDecimal = decimalStr.trimmed().toUpper().remove(' ');
+        QString num = sanitizedDecimal.trimmed();
+
+        if (num.isEmpty())
+        {
+            throw std::invalid_argument("Invalid decimal string provided to BigNum.");
+        }
+
+        // Check if the number is negative
+        bool isNegative = false;
+        if (num[0] == '-')
+        {
+            isNegative = true;
+            num = num.mid(1); // Remove the '-' sign for further processing
+        }
+
+        if (num.isEmpty() || !std::all_of(num.begin(), num.end(), [](QChar c) { return c.isDigit(); }))
+        {
+            throw std::invalid_argument("Invalid decimal string provided to BigNum.");
+        }
+
+        /* Horner's rule on 18 digits at a time as 10^18 still fits in a word */
+        constexpr int CHUNK_DIGITS = 18;
+        constexpr uint64_t CHUNK_BASE = 1000000000000000000ULL;
+        int end = num.length() % CHUNK_DIGITS;
+        if (end == 0)
+        {
+            end = CHUNK_DIGITS;
+        }
+        for (int start = 0; start < num.length(); start = end, end += CHUNK_DIGITS)
+        {
+            uint64_t chunk = 0;
+            for (int i = start; i < end; ++i)
+            {
+                int digit = num[i].digitValue();
+                if (digit < 0)
+                {
+                    throw std::invalid_argument("Invalid character in decimal string.");
+                }
+                chunk = chunk * 10 + digit;
+            }
+
+            // result = result * 10^18 + chunk in one pass
+            uint64_t carry = QBigNumKernels::mul1(result.data.data(), result.data.data(), NUM_WORDS,
+                                                  (start == 0) ? 1 : CHUNK_BASE, chunk);
+
+            if (carry != 0 || result.isNegative())
+            {
+                throw std::overflow_error("Decimal number exceeds the maximum value for BigNum.");
+            }
+        }
+
+        if (isNegative)
+        {
+            result = -result;
+        }
+
+        return result;
+    }
+
+    static QBigNum fromHex(const QString& hex)
+    {
+        QBigNum result;
+        QString sanitizedHex = hex.trimmed().toUpper().remove(' ');
+
+        bool string_is_negative = false;
+        if (sanitizedHex.startsWith("-"))
+        {
+            string_is_negative = true;
+            sanitizedHex = sanitizedHex.mid(1);
+        }
+
+        // Remove "0x" if present
+        if (sanitizedHex.startsWith("0X"))
+        {
+            sanitizedHex = sanitizedHex.mid(2);
+        }
+
+        // Pad the string to a multiple of 16 characters
+        while (sanitizedHex.length() % 16 != 0)
+        {
+            sanitizedHex.prepend('0');
+        }
+
+        // Parse the hex string into 64-bit chunks
+        int index = 0;
+        for (int i = sanitizedHex.length(); i > 0 && index <= NUM_WORDS; i -= 16)
+        {
+            if (index == NUM_WORDS)
+            {
+                throw std::overflow_error("Hexidecimal number exceeds the maximum value for BigNum.");
+            }
+
+            QString chunk = sanitizedHex.mid(i - 16, 16);
+            bool ok;
+            result.data[index++] = chunk.toULongLong(&ok, 16);
+
+            if (!ok)
+            {
+                throw std::invalid_argument("Invalid hex string provided to BigNum.");
+            }
+        }
+
+        if (result.isNegative())
+        {
+            throw std::overflow_error("Hexidecimal number exceeds the maximum value for BigNum.");
+        }
+
+        if (string_is_negative)
+        {
+            result = -result;
+        }
+
+        return result;
+    }
+
+    /* Parses the characters of an integer literal, hex (0x), binary (0b) or decimal with optional ' separators.
+     * Being constexpr it lets constants be built at compile time, see DEFINE_QBIGNUM_LITERAL */
+    static constexpr QBigNum fromLiteral(const char* literal, size_t length)
+    {
+        QBigNum result;
+        uint64_t base = 10;
+        size_t i = 0;
+
+        if (length > 2 && literal[0] == '0' && (literal[1] == 'x' || literal[1] == 'X'))
+        {
+            base = 16;
+            i = 2;
+        }
+        else if (length > 2 && literal[0] == '0' && (literal[1] == 'b' || literal[1] == 'B'))
+        {
+            base = 2;
+            i = 2;
+        }
+
+        for (; i < length; ++i)
+        {
+            char c = literal[i];
+            uint64_t digit = 0;
+            if (c == '\'')
+            {
+                continue; // Digit separator
+            }
+            if (c >= '0' && c <= '9')
+            {
+                digit = c - '0';
+            }
+            else if (c >= 'a' && c <= 'f')
+            {
+                digit = c - 'a' + 10;
+            }
+            else if (c >= 'A' && c <= 'F')
+            {
+                digit = c - 'A' + 10;
+            }
+            else
+            {
+                throw std::invalid_argument("Invalid character in BigNum literal.");
+            }
+            if (digit >= base)
+            {
+                throw std::invalid_argument("Invalid digit in BigNum literal.");
+            }
+
+            // result = result * base + digit
+            __uint128_t carry = digit;
+            for (int k = 0; k < NUM_WORDS; ++k)
+            {
+                __uint128_t acc = (__uint128_t)result.data[k] * base + carry;
+                result.data[k] = static_cast<uint64_t>(acc);
+                carry = acc >> 64;
+            }
+
+            if (carry != 0 || result.isNegative())
+            {
+                throw std::overflow_error("Literal exceeds the maximum value for BigNum.");
+            }
+        }
+
+        return result;
+    }
+
+    /* Compile time only version of fromLiteral, used by the user-defined literals */
+    template <char... Chars>
+    static constexpr QBigNum literal()
+    {
+        constexpr char chars[] = {Chars...};
+        constexpr QBigNum value = fromLiteral(chars, sizeof...(Chars));
+        return value;
+    }
+
+    static QBigNum randomInRange(const QBigNum& min, const QBigNum& max)
+    {
+        if (min > max)
+        {
+            throw std::invalid_argument("min must be <= max");
+        }
+
+        QBigNum range = max - min + 1; // Inclusive range
+
+        QBigNum result = 0;
+        QBigNum multiplier = 1;
+
+        while (range > 0)
+        {
+            // Generate a random 64-bit integer using QRandomGenerator
+            uint64_t randomPart = QRandomGenerator::global()->generate64();
+
+            // Ensure randomPart fits within the current range
+            QBigNum part = QBigNum(randomPart) % range;
+
+            // Accumulate the random result
+            result += part * multiplier;
+
+            // Adjust the range for the next iteration
+            range >>= 64;
+            multiplier <<= 64;
+        }
+
+        return min + result % (max - min + 1);
+    }
+
+    // Randomize QBigNum with specified number of bits
+    static QBigNum randomize(int numBits, bool negative)
+    {
+        if (numBits <= 0)
+        {
+            return QBigNum();
+        }
+
+        QBigNum result;
+        int numWords = (numBits + 63) / 64; // Determine how many 64-bit words needed
+        int remainingBits = numBits % 64;
+
+        // Fill the QBigNum with random words using QRandomGenerator
+        for (int i = 0; i < numWords; ++i)
+        {
+            result.data[i] = QRandomGenerator::global()->generate64();
+        }
+
+        // Mask unused bits in the highest word
+        if (remainingBits > 0)
+        {
+            quint64 mask = (1ULL << remainingBits) - 1;
+            result.data[numWords - 1] &= mask;
+        }
+
+        result.data[NUM_WORDS - 1] &= ~(1ULL<<63);
+        if (negative)
+        {
+            result = -result;
+        }
+
+        return result;
+    }
+
+    static QString UInt128ToHexString(const __uint128_t& value)
+    {
+        // Split the 128-bit value into high and low 64-bit parts
+        uint64_t high = static_cast<uint64_t>(value >> 64);
+        uint64_t low = static_cast<uint64_t>(value);
+
+        // Format the output as a hexadecimal string
+        QString hexString = QString("0x%1%2")
+                                .arg(high, 16, 16, QChar('0'))
+                                .arg(low, 16, 16, QChar('0'));
+
+        return hexString;
+    }
+
+    static QString UInt64ToHexString(uint64_t value)
+    {
+        // Format the value as a 64-bit hexadecimal string
+        QString hexString = QString("0x%1").arg(value, 16, 16, QChar('0'));
+        return hexString;
+    }
+
+    QBigNum reverseByteOrder(size_t reflectionBytes) const
+    {
+        QBigNum reversed;
+
+        constexpr size_t NUM_BYTES = Bits / 8; // Total bytes in the number
+        constexpr size_t NUM_WORDS = NUM_BYTES / sizeof(uint64_t); // Number of 64-bit words
+        const size_t reflectionWords = reflectionBytes / sizeof(uint64_t); // Words to reflect around
+
+        // Sanity check for reflectionBytes
+        if (reflectionBytes > NUM_BYTES)
+        {
+            throw std::invalid_argument("Reflection point exceeds number size");
+        }
+
+        for (size_t i = 0; i < reflectionWords; ++i)
+        {
+            // Reverse byte order of each word and reflect around the specified point
+            uint64_t word = data[i];
+            word = ((word & 0x00000000000000FFULL) << 56) |
+                   ((word & 0x000000000000FF00ULL) << 40) |
+                   ((word & 0x0000000000FF0000ULL) << 24) |
+                   ((word & 0x00000000FF000000ULL) << 8)  |
+                   ((word & 0x000000FF00000000ULL) >> 8)  |
+                   ((word & 0x0000FF0000000000ULL) >> 24) |
+                   ((word & 0x00FF000000000000ULL) >> 40) |
+                   ((word & 0xFF00000000000000ULL) >> 56);
+
+            // Reflect the word around the specified byte
+            size_t targetWord = (reflectionWords - 1) - i;
+            reversed.data[targetWord] = word;
+        }
+
+        // Copy any remaining bytes (not part of the reflection area)
+        for (size_t i = reflectionWords; i < NUM_WORDS; ++i)
+        {
+            reversed.data[i] = data[i];
+        }
+
+        return reversed;
+    }
+
+    // Set the bit at the specified index
+    constexpr void setBit(size_t index)
+    {
+        // Find the word index and the position of the bit in that word
+        size_t wordIndex = index / 64;
+        size_t bitPosition = index % 64;
+
+        // Set the bit at the correct position
+        data[wordIndex] |= (1ULL << bitPosition);
+    }
+
+    // Clear the bit at the specified index
+    constexpr void clearBit(size_t index)
+    {
+        // Find the word index and the position of the bit in that word
+        size_t wordIndex = index / 64;
+        size_t bitPosition = index % 64;
+
+        // Clear the bit at the correct position
+        data[wordIndex] &= ~(1ULL << bitPosition);
+    }
+
+    // Read the bit at the specified index, two's complement so -ve numbers have their high bits set
+    constexpr bool testBit(size_t index) const
+    {
+        return (data[index / 64] >> (index % 64)) & 1;
+    }
+
+};
+
+/* Barrett reduction by a fixed modulus m > 0 of k words. mu = floor(2^(128k) / m) is worked out once, after
+   that reducing anything below 2^(128k), which includes the product of two reduced numbers, takes two
+   multiplies and at most two subtractions of m instead of a long division (HAC 14.42) */
+template <size_t Bits>
+class QBigNumBarrett
+{
+public:
+    static constexpr bool IsQBigNumReducer = true;
+
+    explicit QBigNumBarrett(const QBigNum<Bits>& modulus)
+        : m(modulus)
+    {
+        if (modulus <= 0)
+        {
+            throw std::invalid_argument("Modulus must be positive.");
+        }
+
+        k = QBigNumKernels::normalizedSize(m.data.data(), NUM_WORDS);
+        std::copy(m.data.begin(), m.data.begin() + k, mw.begin());
+        std::fill(mw.begin() + k, mw.end(), 0);
+
+        /* mu needs k + 2 words when m is a power of 2^64, it's at most 2^(64(k+1)) */
+        std::array<uint64_t, 2 * NUM_WORDS + 1> numerator{};
+        numerator[2 * k] = 1;
+        std::array<uint64_t, NUM_WORDS + 2> remainder;
+        std::array<uint64_t, QBigNumKernels::divRemScratchSize(2 * NUM_WORDS + 1, NUM_WORDS)> scratch;
+        mu.fill(0);
+        QBigNumKernels::divRem(mu.data(), remainder.data(), numerator.data(), 2 * k + 1, mw.data(), k, scratch.data());
+        muSize = QBigNumKernels::normalizedSize(mu.data(), k + 2);
+    }
+
+    const QBigNum<Bits>& modulus() const
+    {
+        return m;
     }
 
-    bool operator<(int64_t scalar) const
+    /* x mod m in [0, m), falls back to a division when x is too wide for the Barrett bound */
+    QBigNum<Bits> reduce(const QBigNum<2 * Bits>& x) const
     {
-        QBigNum other = QBigNum(scalar);
-        return *this < other;
+        QBigNum<2 * Bits> ux = QBigNum<2 * Bits>::abs(x);
+        int xn = QBigNumKernels::normalizedSize(ux.data.data(), 2 * NUM_WORDS);
+        if (xn > 2 * k)
+        {
+            QBigNum<2 * Bits> mbig;
+            QBigNum<Bits>::copy(m, mbig);
+            ux = x % mbig;
+            return finish(ux.data.data(), QBigNumKernels::normalizedSize(ux.data.data(), k), false);
+        }
+        return finish(ux.data.data(), xn, x.isNegative());
     }
 
-    bool operator>(int64_t scalar) const
+    QBigNum<Bits> reduce(const QBigNum<Bits>& x) const
     {
-        QBigNum other = QBigNum(scalar);
-        return *this > other;
+        QBigNum<Bits> ux = QBigNum<Bits>::abs(x);
+        int xn = QBigNumKernels::normalizedSize(ux.data.data(), NUM_WORDS);
+        if (xn > 2 * k)
+        {
+            return x % m;
+        }
+        return finish(ux.data.data(), xn, x.isNegative());
     }
 
-    bool operator<=(int64_t scalar) const
+    QBigNum<Bits> mulMod(const QBigNum<Bits>& a, const QBigNum<Bits>& b) const
     {
-        QBigNum other = QBigNum(scalar);
-        return *this <= other;
+        return reduce(QBigNum<Bits>::mulWide(a, b));
     }
 
-    bool operator>=(int64_t scalar) const
+    QBigNum<Bits> sqrMod(const QBigNum<Bits>& a) const
     {
-        QBigNum other = QBigNum(scalar);
-        return *this >= other;
+        return reduce(QBigNum<Bits>::sqrWide(a));
     }
 
-    bool operator>=(const QBigNum& other) const
+    QBigNum<Bits> powMod(const QBigNum<Bits>& base, const QBigNum<Bits>& exp) const
     {
-        // Handle sign mismatch
-        if (isNegative() != other.isNegative())
+        if (exp < 0)
         {
-            return !isNegative();
+            return powMod(base.inverseMod(m), -exp);
         }
-        for (int i = NUM_WORDS - 1; i >= 0; --i)
+
+        return QBigNum<Bits>::windowedPow(reduce(base), exp, reduce(QBigNum<Bits>(1)),
+                                          [this](const QBigNum<Bits>& x, const QBigNum<Bits>& y) { return mulMod(x, y); },
+                                          [this](const QBigNum<Bits>& x) { return sqrMod(x); });
+    }
+
+private:
+    static constexpr int NUM_WORDS = NUM_WORDS(Bits);
+    static constexpr QBigNumKernels::MulThresholds mulThresholds{QBigNumThresholds<Bits>::karatsuba, QBigNumThresholds<Bits>::toom3, QBigNumThresholds<Bits>::ntt};
+
+    QBigNum<Bits> m;
+    int k;
+    int muSize;
+    std::array<uint64_t, NUM_WORDS + 1> mw; // m with a zero word on top for the k + 1 word arithmetic
+    std::array<uint64_t, NUM_WORDS + 2> mu;
+
+    /* product[0..an+bn) = a * b, the operands are at most NUM_WORDS + 2 words */
+    static void mulMagnitudes(uint64_t* product, const uint64_t* a, int an, const uint64_t* b, int bn)
+    {
+        if (qMin(an, bn) < mulThresholds.karatsuba || qMin(an, bn) >= mulThresholds.ntt)
         {
-            if (data[i] > other.data[i]) return true;
-            if (data[i] < other.data[i]) return false;
+            QBigNumKernels::mul(product, a, an, b, bn, nullptr, mulThresholds);
+            return;
         }
-        return true; // Equal case
+        std::array<uint64_t, QBigNumKernels::mulScratchSize(qMin(NUM_WORDS + 2, mulThresholds.ntt))> scratch;
+        QBigNumKernels::mul(product, a, an, b, bn, scratch.data(), mulThresholds);
     }
 
-    bool operator<=(const QBigNum& other) const
+    /* Reduces the magnitude x[0..xn) for xn <= 2k and gives it the sign of x, floor style */
+    QBigNum<Bits> finish(const uint64_t* x, int xn, bool negative) const
     {
-        // Handle sign mismatch
-        if (isNegative() != other.isNegative())
+        int n = words();
+        /* r = x - floor(floor(x / b^(k-1)) mu / b^(k+1)) m mod b^(k+1), with b = 2^64 */
+        std::array<uint64_t, NUM_WORDS + 1> r{};
+        std::copy(x, x + qMin(xn, n + 1), r.begin());
+        int q1n = qMin(xn, 2 * n) - (n - 1); // xn <= 2k already, this and muSize are clamped so the compiler can bound q2
+        if (q1n > 0)
+        {
+            std::array<uint64_t, 2 * NUM_WORDS + 4> q2;
+            mulMagnitudes(q2.data(), x + n - 1, q1n, mu.data(), qMin(muSize, int(NUM_WORDS) + 2));
+            int q3n = qMin(q1n + muSize - (n + 1), n + 1);
+            if (q3n > 0)
+            {
+                std::array<uint64_t, NUM_WORDS + 1> q3m;
+                QBigNumKernels::mulLow(q3m.data(), n + 1, q2.data() + n + 1, q3n, mw.data(), n);
+                QBigNumKernels::sub(r.data(), r.data(), q3m.data(), n + 1);
+            }
+        }
+
+        /* The estimate is at most two short */
+        while (QBigNumKernels::compare(r.data(), mw.data(), n + 1) >= 0)
         {
-            return isNegative();
+            QBigNumKernels::sub(r.data(), r.data(), mw.data(), n + 1);
         }
-        for (int i = NUM_WORDS - 1; i >= 0; --i)
+
+        QBigNum<Bits> result;
+        std::copy(r.begin(), r.begin() + n, result.data.begin());
+        std::fill(result.data.begin() + n, result.data.end(), 0);
+        if (negative && QBigNumKernels::normalizedSize(result.data.data(), n) != 0)
         {
-            if (data[i] > other.data[i]) return false;
-            if (data[i] < other.data[i]) return true;
+            QBigNumKernels::sub(result.data.data(), mw.data(), result.data.data(), n);
         }
-        return true; // Equal case
+        return result;
     }
 
-    bool operator<(const QBigNum& other) const
+    /* k, never less than 1 or more than NUM_WORDS, spelt out so the compiler can bound the copies into the fixed
+       arrays */
+    int words() const
     {
-        return !(*this>=other);
+        return qMax(1, qMin(k, int(NUM_WORDS)));
     }
+};
 
-    bool operator>(const QBigNum& other) const
-    {
-        return !(*this<=other);
-    }
+/* Montgomery arithmetic modulo an odd m > 0 of k words, with R = 2^(64k). Numbers in Montgomery form are
+   aR mod m, in [0, m), and multiplying two of them needs a REDC instead of a division. R^2 mod m and
+   -m^-1 mod 2^64 are worked out once, toMont and fromMont convert in and out */
+template <size_t Bits>
+class QBigNumMontgomery
+{
+public:
+    static constexpr bool IsQBigNumReducer = true;
 
-    bool operator==(const QBigNum& other) const
+    explicit QBigNumMontgomery(const QBigNum<Bits>& modulus)
+        : m(modulus)
     {
-        if (isNegative() != other.isNegative())
+        if (modulus <= 0 || !(modulus.data[0] & 1))
         {
-            return false;
+            throw std::invalid_argument("Montgomery modulus must be odd and positive.");
         }
-        for (int i = NUM_WORDS - 1; i >= 0; --i)
+
+        k = QBigNumKernels::normalizedSize(m.data.data(), NUM_WORDS);
+
+        /* Newton's iteration doubles the correct low bits each step, m * m == 1 mod 8 gives the first 3 */
+        uint64_t inverse = m.data[0];
+        for (int i = 0; i < 5; ++i)
         {
-            if (data[i] > other.data[i]) return false;
-            if (data[i] < other.data[i]) return false;
+            inverse *= 2 - m.data[0] * inverse;
         }
-        return true; // Equal case
-    }
+        mInv = 0 - inverse;
 
-    bool operator!=(const QBigNum& other) const
-    {
-        return !(*this == other);
+        std::array<uint64_t, 2 * NUM_WORDS + 1> numerator{};
+        numerator[2 * k] = 1;
+        std::array<uint64_t, NUM_WORDS + 2> quotient;
+        std::array<uint64_t, QBigNumKernels::divRemScratchSize(2 * NUM_WORDS + 1, NUM_WORDS)> scratch;
+        r2 = 0;
+        QBigNumKernels::divRem(quotient.data(), r2.data.data(), numerator.data(), 2 * k + 1, m.data.data(), k, scratch.data());
+        one = fromMont(r2);
     }
 
-    int compareAbs(const QBigNum& other) const
+    const QBigNum<Bits>& modulus() const
     {
-        for (int i = NUM_WORDS - 1; i >= 0; i--)
-        {
-            uint64_t thisWord = isNegative() ? ~data[i] + (i == 0 ? 1 : 0) : data[i];
-            uint64_t otherWord = other.isNegative() ? ~other.data[i] + (i == 0 ? 1 : 0) : other.data[i];
-
-            if (thisWord != otherWord)
-            {
-                return (thisWord > otherWord) ? 1 : -1;
-            }
-        }
-        return 0; // Absolute values are equal
+        return m;
     }
 
-    /* Conversion */
-
-    operator QString() const
+    QBigNum<Bits> toMont(const QBigNum<Bits>& a) const
     {
-        return toDecimalString();
+        return mul(a % m, r2);
     }
 
-    int64_t toInt64() const
+    QBigNum<Bits> fromMont(const QBigNum<Bits>& a) const
     {
-        return (int64_t)data[0];
+        std::array<uint64_t, 2 * NUM_WORDS> t{};
+        std::copy(a.data.begin(), a.data.begin() + k, t.begin());
+        QBigNum<Bits> result = 0;
+        QBigNumKernels::montgomeryReduce(result.data.data(), t.data(), m.data.data(), k, mInv);
+        return result;
     }
 
-    template <size_t TargetBits>
-    QBigNum<TargetBits> convertTo() const
+    /* abR^-1 mod m for a and b in Montgomery form, CIOS while the product is schoolbook sized, otherwise the
+       fast full product then a separate REDC */
+    QBigNum<Bits> mul(const QBigNum<Bits>& a, const QBigNum<Bits>& b) const
     {
-        QBigNum<TargetBits> result;
-        size_t minWords = qMin(NUM_WORDS(Bits), NUM_WORDS(TargetBits));
-        for (size_t i = 0; i < minWords; ++i)
+        QBigNum<Bits> result = 0;
+        int n = words();
+        if (n < mulThresholds.karatsuba)
         {
-            result[i] = this->data[i];
+            std::array<uint64_t, 2 * NUM_WORDS + 1> t;
+            QBigNumKernels::montgomeryMul(result.data.data(), a.data.data(), b.data.data(), m.data.data(), n, mInv, t.data());
+            return result;
         }
+        std::array<uint64_t, 2 * NUM_WORDS> t;
+        QBigNum<Bits>::mulMagnitudes(t.data(), a.data.data(), n, b.data.data(), n);
+        QBigNumKernels::montgomeryReduce(result.data.data(), t.data(), m.data.data(), n, mInv);
         return result;
     }
 
-    /* Misc */
-
-    // Static function to get the maximum value QBigNum can represent
-    static QBigNum max()
+    /* Squaring only needs half the limb products, so it always forms the square and then reduces */
+    QBigNum<Bits> sqr(const QBigNum<Bits>& a) const
     {
-        QBigNum maxVal;
-
-        maxVal.data.fill(UINT64_MAX);  // Fill all uint64_t words with 0xFFFFFFFFFFFFFFFF
-
-        // Set the sign bit (most significant bit) to 0
-        maxVal.data.back() &= ~(static_cast<uint64_t>(1) << 63);  // Clear the sign bit (MSB)
-
-        return maxVal;
+        QBigNum<Bits> result = 0;
+        int n = words();
+        std::array<uint64_t, 2 * NUM_WORDS> t;
+        QBigNum<Bits>::sqrMagnitude(t.data(), a.data.data(), n);
+        QBigNumKernels::montgomeryReduce(result.data.data(), t.data(), m.data.data(), n, mInv);
+        return result;
     }
 
-    // Static function to get the minimum value QBigNum can represent
-    static QBigNum min()
+    /* a^exp for a in Montgomery form and exp >= 0, the result stays in Montgomery form */
+    QBigNum<Bits> pow(const QBigNum<Bits>& a, const QBigNum<Bits>& exp) const
     {
-        QBigNum minVal;
+        return QBigNum<Bits>::windowedPow(a, exp, one,
+                                          [this](const QBigNum<Bits>& x, const QBigNum<Bits>& y) { return mul(x, y); },
+                                          [this](const QBigNum<Bits>& x) { return sqr(x); });
+    }
 
-        // The most negative value in two's complement has the highest bit set to 1 and all others set to 0
-        minVal.data.fill(NUM_WORDS, 0);
-        minVal.data.back() = static_cast<uint64_t>(1) << 63; // Set the sign bit (MSB) to 1
+    /* Reducer interface on ordinary numbers, the extra multiply by R^2 mod m cancels the R^-1 of the REDC */
+    QBigNum<Bits> reduce(const QBigNum<Bits>& x) const
+    {
+        return x % m;
+    }
 
-        return minVal;
+    QBigNum<Bits> mulMod(const QBigNum<Bits>& a, const QBigNum<Bits>& b) const
+    {
+        return mul(mul(a % m, b % m), r2);
     }
 
-    void debug(const QString &comment = QString()) const
+    QBigNum<Bits> sqrMod(const QBigNum<Bits>& a) const
     {
-        if (comment.isEmpty())
-        {
-            qDebug() << toDecimalString();
-        }
-        else
-        {
-            qDebug() << comment << ":" << toDecimalString();
-        }
+        return mul(sqr(a % m), r2);
     }
 
-    void setNegative(bool isNegative)
+    QBigNum<Bits> powMod(const QBigNum<Bits>& base, const QBigNum<Bits>& exp) const
     {
-        if (isNegative)
-        {
-            // Set the most significant bit (MSB) of the highest word
-            data[NUM_WORDS - 1] |= (1ULL << 63); // Assuming 64-bit words
-        }
-        else
+        if (exp < 0)
         {
-            // Clear the most significant bit (MSB) of the highest word
-            data[NUM_WORDS - 1] &= ~(1ULL << 63); // Assuming 64-bit words
+            return powMod(base.inverseMod(m), -exp);
         }
+        return fromMont(pow(toMont(base), exp));
     }
 
-    QBigNum twosComplement() const
-    {
-        QBigNum num = *this;
-        __uint128_t carry = 1; // Start with the carry for adding 1
-        for (int i = 0; i < NUM_WORDS; ++i)
-        {
-            // Invert the bits of the current word and add the carry
-            __uint128_t temp = ~num.data[i] + carry;
+private:
+    static constexpr int NUM_WORDS = NUM_WORDS(Bits);
+    static constexpr QBigNumKernels::MulThresholds mulThresholds = QBigNum<Bits>::mulThresholds;
 
-            // Store the lower 64 bits back into the current word
-            num.data[i] = static_cast<uint64_t>(temp);
+    QBigNum<Bits> m;
+    QBigNum<Bits> r2;  // R^2 mod m
+    QBigNum<Bits> one; // R mod m, 1 in Montgomery form
+    int k;
+    uint64_t mInv;     // -m^-1 mod 2^64
 
-            // Compute the carry for the next word
-            carry = temp >> 64; // Extract the carry from the higher bits
-        }
-        return num;
+    /* k, bounded so the compiler can see which multiply tiers a width can never reach */
+    int words() const
+    {
+        return qMin(k, int(NUM_WORDS));
     }
+};
 
-    int bitLength() const
+/* Powers of one fixed base g modulo m by a Lim-Lee comb. An exponent of up to maxExpBits bits is cut into
+   teeth rows of a bits and each row into blocks of b bits. For every block j the table holds all 2^teeth
+   products of g^(2^(ra + jb)) over subsets of rows, so pow takes just b squarings and about a multiplies.
+   The table only depends on g and m, serialize it once and load it with deserialize elsewhere */
+template <size_t Bits>
+class QBigNumFixedBase
+{
+public:
+    QBigNumFixedBase(const QBigNum<Bits>& base, const QBigNum<Bits>& modulus, int maxExpBits = Bits - 1, int teeth = 6, int blocks = 2)
+        : g(base), m(modulus), maxExpBits(maxExpBits), teeth(teeth), blocks(blocks)
     {
+        if (maxExpBits < 1 || maxExpBits > int(Bits) || teeth < 1 || teeth > 16 || blocks < 1 || blocks > maxExpBits)
+        {
+            throw std::invalid_argument("Bad fixed base comb shape.");
+        }
+        setModulus();
 
-        // Handle negative numbers by considering their two's complement representation
-        if (isNegative())
+        /* Row r starts at bit ra, so its generator is g^(2^(ra)) */
+        std::vector<QBigNum<Bits>> rowBases(teeth);
+        QBigNum<Bits> current = toForm(g);
+        for (int r = 0; r < teeth; ++r)
         {
-            // For negative numbers, calculate the bit length of the positive equivalent (ignoring the sign bit)
-            QBigNum<Bits> positiveNum = *this;
-            positiveNum = abs(positiveNum); // Get the absolute value
-            return positiveNum.bitLength();
+            rowBases[r] = current;
+            for (int i = 0; i < rowBits && r < teeth - 1; ++i)
+            {
+                current = sqr(current);
+            }
         }
 
-        for (int i = NUM_WORDS - 1; i >= 0; --i)
+        int entries = 1 << teeth;
+        table.resize(size_t(blocks) * entries);
+        table[0] = one;
+        for (int i = 1; i < entries; ++i)
         {
-            if (data[i] != 0)
+            int r = __builtin_ctz(i);
+            int rest = i & (i - 1);
+            table[i] = (rest == 0) ? rowBases[r] : mul(table[rest], rowBases[r]);
+        }
+        for (int j = 1; j < blocks; ++j)
+        {
+            for (int i = 0; i < entries; ++i)
             {
-                 return (64 * i) + (64 - __builtin_clzll(data[i])) ;
+                QBigNum<Bits> x = table[size_t(j - 1) * entries + i];
+                for (int c = 0; c < blockBits; ++c)
+                {
+                    x = sqr(x);
+                }
+                table[size_t(j) * entries + i] = x;
             }
         }
-        return 0;
     }
 
-    bool isNegative() const
+    const QBigNum<Bits>& base() const
     {
-        return (data[NUM_WORDS - 1] >> 63);
+        return g;
     }
 
-    QString toWordString() const
+    const QBigNum<Bits>& modulus() const
     {
-        QString result;
-        for (int i = NUM_WORDS - 1; i >= 0; --i)
-        {
-            result += QString("0x%1 ").arg(data[i], 16, 16, QChar('0'));
-        }
-        result = result.trimmed();
-        return result;
+        return m;
     }
 
-    QString toHexString() const
+    /* g^exp mod m, exponents past maxExpBits fall back to powMod */
+    QBigNum<Bits> pow(const QBigNum<Bits>& exp) const
     {
-        QString result;
-        QBigNum temp = *this;
-        if (temp.isNegative())
+        if (exp < 0)
         {
-            result += "-";
-            temp = -temp;
+            return pow(-exp).inverseMod(m);
         }
-        result += "0x";
-        bool isprinting = false;
-        for (int i = NUM_WORDS - 1; i >= 0; --i)
+        if (exp.bitLength() > maxExpBits)
         {
-            if (!isprinting && temp.data[i] == 0)
-            {
-                continue;
-            }
-            if (isprinting)
+            return g.powMod(exp, m);
+        }
+
+        int entries = 1 << teeth;
+        QBigNum<Bits> result = one;
+        bool started = false;
+        for (int c = blockBits - 1; c >= 0; --c)
+        {
+            if (started)
             {
-                result += QString("%1").arg(temp.data[i], 16, 16, QChar('0'));
+                result = sqr(result);
             }
-            else
+            for (int j = blocks - 1; j >= 0; --j)
             {
-                result += QString("%1").arg(temp.data[i], 0, 16, QChar('0'));
+                int column = j * blockBits + c;
+                if (column >= rowBits)
+                {
+                    continue;
+                }
+                int index = 0;
+                for (int r = 0; r < teeth; ++r)
+                {
+                    int bit = r * rowBits + column;
+                    if (bit < maxExpBits && exp.testBit(bit))
+                    {
+                        index |= 1 << r;
+                    }
+                }
+                if (index != 0)
+                {
+                    const QBigNum<Bits>& entry = table[size_t(j) * entries + index];
+                    result = started ? mul(result, entry) : entry;
+                    started = true;
+                }
             }
-            isprinting = true;
         }
-        if (!isprinting)
+        return fromForm(result);
+    }
+
+    /* Little endian 64 bit words: "QBFB", version, Bits, maxExpBits, teeth, blocks, m, g and the table */
+    QByteArray serialize() const
+    {
+        QByteArray bytes("QBFB");
+        for (uint64_t field : {uint64_t(1), uint64_t(Bits), uint64_t(maxExpBits), uint64_t(teeth), uint64_t(blocks)})
         {
-            result += "00";
+            putWord(bytes, field);
         }
-        return result;
+        putNumber(bytes, m);
+        putNumber(bytes, g);
+        for (const QBigNum<Bits>& entry : table)
+        {
+            putNumber(bytes, entry);
+        }
+        return bytes;
     }
 
-    QString toDecimalString() const
+    static QBigNumFixedBase deserialize(const QByteArray& bytes)
     {
-        QString result;
-        QBigNum temp = *this; // Copy of the original number for manipulation
-
-        // Handle zero as a special case
-        if (temp == 0)
+        int offset = 4;
+        if (bytes.size() < 4 + 5 * 8 || bytes.mid(0, 4) != QByteArray("QBFB") || getWord(bytes, offset) != 1 ||
+            getWord(bytes, offset) != Bits)
         {
-            return "0";
+            throw std::invalid_argument("Not a fixed base table for this width.");
         }
 
-        temp = QBigNum::abs(temp);
-
-        // Convert the absolute value to a decimal string
-        while (temp > 0)
+        QBigNumFixedBase fixed;
+        fixed.maxExpBits = int(getWord(bytes, offset));
+        fixed.teeth = int(getWord(bytes, offset));
+        fixed.blocks = int(getWord(bytes, offset));
+        if (fixed.maxExpBits < 1 || fixed.maxExpBits > int(Bits) || fixed.teeth < 1 || fixed.teeth > 16 || fixed.blocks < 1 ||
+            fixed.blocks > fixed.maxExpBits || bytes.size() != qsizetype(offset + ((size_t(fixed.blocks) << fixed.teeth) + 2) * NUM_WORDS * 8))
         {
-            auto [quotient, remainder] = temp / 10;
-            temp = quotient;
-            result.prepend(QString::number(remainder[0]));
+            throw std::invalid_argument("Not a fixed base table for this width.");
         }
 
-        // Add the negative sign if necessary
-        if (isNegative())
+        fixed.m = getNumber(bytes, offset);
+        fixed.g = getNumber(bytes, offset);
+        fixed.setModulus();
+        fixed.table.resize(size_t(fixed.blocks) << fixed.teeth);
+        for (QBigNum<Bits>& entry : fixed.table)
         {
-            result.prepend('-');
+            entry = getNumber(bytes, offset);
         }
-
-        return result;
+        return fixed;
     }
 
-    static QBigNum fromDecimal(const QString& decimalStr)
-    {
-        QBigNum result;
-        QString sanitizedDecimal = decimalStr.trimmed().toUpper().remove(' ');
-        QString num = sanitizedDecimal.trimmed();
+private:
+    static constexpr int NUM_WORDS = NUM_WORDS(Bits);
 
-        if (num.isEmpty())
+    QBigNum<Bits> g;
+    QBigNum<Bits> m;
+    int maxExpBits = 0;
+    int teeth = 0;
+    int blocks = 0;
+    int rowBits = 0;   // a, exponent bits per row
+    int blockBits = 0; // b, bits per block and the number of squarings in pow
+    QBigNum<Bits> one; // 1 in the working form
+    std::vector<QBigNum<Bits>> table;
+
+    /* Odd moduli keep the table in Montgomery form, even ones as plain residues reduced by Barrett */
+    std::optional<QBigNumMontgomery<Bits>> mont;
+    std::optional<QBigNumBarrett<Bits>> barrett;
+
+    QBigNumFixedBase() = default;
+
+    void setModulus()
+    {
+        if (m <= 0)
         {
-            throw std::invalid_argument("Invalid decimal string provided to BigNum.");
+            throw std::invalid_argument("Modulus must be positive.");
         }
-
-        // Check if the number is negative
-        bool isNegative = false;
-        if (num[0] == '-')
+        rowBits = (maxExpBits + teeth - 1) / teeth;
+        blockBits = (rowBits + blocks - 1) / blocks;
+        if (m.testBit(0))
         {
-            isNegative = true;
-            num = num.mid(1); // Remove the '-' sign for further processing
+            mont.emplace(m);
         }
-
-        if (num.isEmpty() || !std::all_of(num.begin(), num.end(), [](QChar c) { return c.isDigit(); }))
+        else
         {
-            throw std::invalid_argument("Invalid decimal string provided to BigNum.");
+            barrett.emplace(m);
         }
+        one = toForm(1);
+    }
 
-        QBigNum base;
-        base.data[0] = 1; // Base starts as 1
+    QBigNum<Bits> toForm(const QBigNum<Bits>& x) const
+    {
+        return mont ? mont->toMont(x) : barrett->reduce(x);
+    }
 
-        for (int i = num.length() - 1; i >= 0; --i)
-        {
-            int digit = num[i].digitValue();
-            if (digit < 0)
-            {
-                throw std::invalid_argument("Invalid character in decimal string.");
-            }
+    QBigNum<Bits> fromForm(const QBigNum<Bits>& x) const
+    {
+        return mont ? mont->fromMont(x) : x;
+    }
 
-            // Multiply current base by the digit
-            result += base * static_cast<uint64_t>(digit);
+    QBigNum<Bits> mul(const QBigNum<Bits>& x, const QBigNum<Bits>& y) const
+    {
+        return mont ? mont->mul(x, y) : barrett->mulMod(x, y);
+    }
 
-            if (result.isNegative())
-            {
-                throw std::overflow_error("Decimal number exceeds the maximum value for BigNum.");
-            }
+    QBigNum<Bits> sqr(const QBigNum<Bits>& x) const
+    {
+        return mont ? mont->sqr(x) : barrett->sqrMod(x);
+    }
 
-            // Update the base (multiply by 10)
-            base *= 10;
+    static void putWord(QByteArray& bytes, uint64_t word)
+    {
+        char buffer[8];
+        for (int i = 0; i < 8; ++i)
+        {
+            buffer[i] = char(word >> (8 * i));
         }
+        bytes.append(buffer, 8);
+    }
 
-        if (isNegative)
+    static uint64_t getWord(const QByteArray& bytes, int& offset)
+    {
+        uint64_t word = 0;
+        for (int i = 0; i < 8; ++i)
         {
-            result = -result;
+            word |= uint64_t(uint8_t(bytes.constData()[offset + i])) << (8 * i);
         }
-
-        return result;
+        offset += 8;
+        return word;
     }
 
-    static QBigNum fromHex(const QString& hex)
+    static void putNumber(QByteArray& bytes, const QBigNum<Bits>& x)
     {
-        QBigNum result;
-        QString sanitizedHex = hex.trimmed().toUpper().remove(' ');
-
-        bool string_is_negative = false;
-        if (sanitizedHex.startsWith("-"))
+        for (int i = 0; i < NUM_WORDS; ++i)
         {
-            string_is_negative = true;
-            sanitizedHex = sanitizedHex.mid(1);
+            putWord(bytes, x[i]);
         }
+    }
 
-        // Remove "0x" if present
-        if (sanitizedHex.startsWith("0X"))
+    static QBigNum<Bits> getNumber(const QByteArray& bytes, int& offset)
+    {
+        QBigNum<Bits> x;
+        for (int i = 0; i < NUM_WORDS; ++i)
         {
-            sanitizedHex = sanitizedHex.mid(2);
+            x[i] = getWord(bytes, offset);
         }
+        return x;
+    }
+};
 
-        // Pad the string to a multiple of 16 characters
-        while (sanitizedHex.length() % 16 != 0)
+/* Reduction by a special form modulus p = 2^k - sum c_i 2^(e_i) with e_i < k, e.g. the pseudo Mersenne
+   2^255 - 19 or the Solinas prime P-256 = 2^256 - 2^224 + 2^192 + 2^96 - 1. Since 2^k == sum c_i 2^(e_i) mod p
+   the bits of x above k can be folded back in with shifts and small multiplies. 2^k - c with a one word c
+   gets its own two fold path and beats Montgomery as the numbers grow. When k and every e_i are multiples
+   of 32 and p < 2^k, as for the NIST primes, a product of residues is reduced in one pass of 32 bit word
+   sums instead. Other forms fold k - max(e_i) bits at a time */
+template <size_t Bits>
+class QBigNumSolinas
+{
+public:
+    static constexpr bool IsQBigNumReducer = true;
+
+    /* A term (e, c) stands for c 2^e, p = 2^k - sum of the terms */
+    QBigNumSolinas(int k, const QList<QPair<int, int64_t>>& terms)
+        : k(k), terms(terms)
+    {
+        if (k < 2 || k >= int(Bits))
         {
-            sanitizedHex.prepend('0');
+            throw std::invalid_argument("Special modulus exponent out of range.");
         }
 
-        // Parse the hex string into 64-bit chunks
-        int index = 0;
-        for (int i = sanitizedHex.length(); i > 0 && index <= NUM_WORDS; i -= 16)
+        /* The folds only converge if the terms together stay below 2^(k-1), that also keeps p > 2^(k-1) */
+        QBigNum<2 * Bits> bound;
+        QBigNum<2 * Bits> sum;
+        bound.setBit(k - 1);
+        for (const QPair<int, int64_t>& term : terms)
         {
-            if (index == NUM_WORDS)
-            {
-                throw std::overflow_error("Hexidecimal number exceeds the maximum value for BigNum.");
-            }
-
-            QString chunk = sanitizedHex.mid(i - 16, 16);
-            bool ok;
-            result.data[index++] = chunk.toULongLong(&ok, 16);
-
-            if (!ok)
+            if (term.first < 0 || term.first >= k || term.second == 0 || term.second == std::numeric_limits<int64_t>::min())
             {
-                throw std::invalid_argument("Invalid hex string provided to BigNum.");
+                throw std::invalid_argument("Bad special modulus term.");
             }
+            QBigNum<2 * Bits> magnitude(term.second < 0 ? -term.second : term.second);
+            sum += magnitude << term.first;
         }
-
-        if (result.isNegative())
+        if (sum >= bound)
         {
-            throw std::overflow_error("Hexidecimal number exceeds the maximum value for BigNum.");
+            throw std::invalid_argument("Bad special modulus term.");
         }
 
-        if (string_is_negative)
+        QBigNum<2 * Bits> p;
+        p.setBit(k);
+        for (const QPair<int, int64_t>& term : terms)
         {
-            result = -result;
+            QBigNum<2 * Bits> shifted(term.second);
+            p -= shifted << term.first;
         }
-
-        return result;
-    }
-
-    static QBigNum randomInRange(const QBigNum& min, const QBigNum& max)
-    {
-        if (min > max)
+        if (p.bitLength() >= int(Bits))
         {
-            throw std::invalid_argument("min must be <= max");
+            throw std::invalid_argument("Special modulus is too wide.");
         }
-
-        QBigNum range = max - min + 1; // Inclusive range
-
-        QBigNum result = 0;
-        QBigNum multiplier = 1;
-
-        while (range > 0)
+        QBigNum<2 * Bits>::copy(p, m);
+        if (terms.size() == 1 && terms[0].first == 0 && terms[0].second > 0)
         {
-            // Generate a random 64-bit integer using QRandomGenerator
-            uint64_t randomPart = QRandomGenerator::global()->generate64();
+            c = uint64_t(terms[0].second);
+        }
+        else if (m.bitLength() <= k)
+        {
+            /* The word pass leaves x below 2^k, which only covers every residue while p < 2^k */
+            wordTerms = buildWordTerms();
+        }
+    }
 
-            // Ensure randomPart fits within the current range
-            QBigNum part = QBigNum(randomPart) % range;
+    /* Pseudo Mersenne p = 2^k - c with k the bit length of p and 0 < c < 2^62 */
+    explicit QBigNumSolinas(const QBigNum<Bits>& modulus)
+        : QBigNumSolinas(modulus.bitLength(), {{0, pseudoMersenneTerm(modulus)}})
+    {
+    }
 
-            // Accumulate the random result
-            result += part * multiplier;
+    const QBigNum<Bits>& modulus() const
+    {
+        return m;
+    }
 
-            // Adjust the range for the next iteration
-            range >>= 64;
-            multiplier <<= 64;
-        }
+    /* x mod p in [0, p) */
+    QBigNum<Bits> reduce(const QBigNum<2 * Bits>& x) const
+    {
+        return fold(load(x.data.data(), 2 * NUM_WORDS));
+    }
 
-        return min + result % (max - min + 1);
+    QBigNum<Bits> reduce(const QBigNum<Bits>& x) const
+    {
+        return fold(load(x.data.data(), NUM_WORDS));
     }
 
-    // Randomize QBigNum with specified number of bits
-    static QBigNum randomize(int numBits, bool negative)
+    /* Residues are never negative, so the common case multiplies straight into the fold buffer */
+    QBigNum<Bits> mulMod(const QBigNum<Bits>& a, const QBigNum<Bits>& b) const
     {
-        if (numBits <= 0)
+        if (a.isNegative() || b.isNegative())
         {
-            return QBigNum();
+            return reduce(QBigNum<Bits>::mulWide(a, b));
         }
-
-        QBigNum result;
-        int numWords = (numBits + 63) / 64; // Determine how many 64-bit words needed
-        int remainingBits = numBits % 64;
-
-        // Fill the QBigNum with random words using QRandomGenerator
-        for (int i = 0; i < numWords; ++i)
+        int na = QBigNumKernels::normalizedSize(a.data.data(), NUM_WORDS);
+        int nb = QBigNumKernels::normalizedSize(b.data.data(), NUM_WORDS);
+        std::array<uint64_t, WIDE_WORDS> x{};
+        if (na != 0 && nb != 0)
         {
-            result.data[i] = QRandomGenerator::global()->generate64();
+            QBigNum<Bits>::mulMagnitudes(x.data(), a.data.data(), na, b.data.data(), nb);
         }
+        return fold(x);
+    }
 
-        // Mask unused bits in the highest word
-        if (remainingBits > 0)
+    QBigNum<Bits> sqrMod(const QBigNum<Bits>& a) const
+    {
+        if (a.isNegative())
         {
-            quint64 mask = (1ULL << remainingBits) - 1;
-            result.data[numWords - 1] &= mask;
+            return reduce(QBigNum<Bits>::sqrWide(a));
         }
-
-        result.data[NUM_WORDS - 1] &= ~(1ULL<<63);
-        if (negative)
+        int na = QBigNumKernels::normalizedSize(a.data.data(), NUM_WORDS);
+        std::array<uint64_t, WIDE_WORDS> x{};
+        if (na != 0)
         {
-            result = -result;
+            QBigNum<Bits>::sqrMagnitude(x.data(), a.data.data(), na);
         }
-
-        return result;
+        return fold(x);
     }
 
-    static QString UInt128ToHexString(const __uint128_t& value)
+    QBigNum<Bits> powMod(const QBigNum<Bits>& base, const QBigNum<Bits>& exp) const
     {
-        // Split the 128-bit value into high and low 64-bit parts
-        uint64_t high = static_cast<uint64_t>(value >> 64);
-        uint64_t low = static_cast<uint64_t>(value);
-
-        // Format the output as a hexadecimal string
-        QString hexString = QString("0x%1%2")
-                                .arg(high, 16, 16, QChar('0'))
-                                .arg(low, 16, 16, QChar('0'));
+        if (exp < 0)
+        {
+            return powMod(base.inverseMod(m), -exp);
+        }
 
-        return hexString;
+        return QBigNum<Bits>::windowedPow(reduce(base), exp, reduce(QBigNum<Bits>(1)),
+                                          [this](const QBigNum<Bits>& x, const QBigNum<Bits>& y) { return mulMod(x, y); },
+                                          [this](const QBigNum<Bits>& x) { return sqrMod(x); });
     }
 
-    static QString UInt64ToHexString(uint64_t value)
+private:
+    static constexpr int NUM_WORDS = NUM_WORDS(Bits);
+    static constexpr int WIDE_WORDS = 2 * NUM_WORDS + 1; // a double width product and room for the sign
+
+    /* 32 bit word from of the high half of x added coef times into word to of the low half */
+    struct WordTerm
     {
-        // Format the value as a 64-bit hexadecimal string
-        QString hexString = QString("0x%1").arg(value, 16, 16, QChar('0'));
-        return hexString;
+        int to;
+        int from;
+        int64_t coef;
+    };
+
+    int k;
+    QList<QPair<int, int64_t>> terms;
+    uint64_t c = 0; // set for the pseudo Mersenne 2^k - c, which has its own fold
+    std::vector<WordTerm> wordTerms; // set when every exponent is a multiple of 32, like the NIST primes
+    QBigNum<Bits> m;
+
+    static int64_t pseudoMersenneTerm(const QBigNum<Bits>& modulus)
+    {
+        int k = modulus.bitLength();
+        if (modulus <= 0 || k >= int(Bits))
+        {
+            throw std::invalid_argument("Modulus must be positive.");
+        }
+        QBigNum<Bits> difference;
+        difference.setBit(k);
+        difference -= modulus;
+        if (difference.bitLength() > 62)
+        {
+            throw std::invalid_argument("Modulus is not of the form 2^k - c with a small c.");
+        }
+        return static_cast<int64_t>(difference[0]);
     }
 
-    QBigNum reverseByteOrder(size_t reflectionBytes) const
+    /* Sign extends the two's complement number a[0..an) to the fold buffer */
+    static std::array<uint64_t, WIDE_WORDS> load(const uint64_t* a, int an)
     {
-        QBigNum reversed;
+        std::array<uint64_t, WIDE_WORDS> x;
+        std::copy(a, a + an, x.begin());
+        std::fill(x.begin() + an, x.end(), (a[an - 1] >> 63) ? ~uint64_t(0) : 0);
+        return x;
+    }
 
-        constexpr size_t NUM_BYTES = Bits / 8; // Total bytes in the number
-        constexpr size_t NUM_WORDS = NUM_BYTES / sizeof(uint64_t); // Number of 64-bit words
-        const size_t reflectionWords = reflectionBytes / sizeof(uint64_t); // Words to reflect around
+    /* Reduces the two's complement number x into [0, p). The working value lives in a signed buffer and
+       whenever it goes negative it is replaced by -x - 1, a plain bitwise not, so the folds only ever see
+       magnitudes. An odd number of flips means the answer is p - 1 - x */
+    QBigNum<Bits> fold(std::array<uint64_t, WIDE_WORDS> x) const
+    {
+        bool flipped = false;
 
-        // Sanity check for reflectionBytes
-        if (reflectionBytes > NUM_BYTES)
+        int top = k / 64;
+        uint64_t lowMask = (uint64_t(1) << (k % 64)) - 1;
+        if (c != 0 && !(x[WIDE_WORDS - 1] >> 63))
         {
-            throw std::invalid_argument("Reflection point exceeds number size");
+            return foldPseudoMersenne(x, top, lowMask);
         }
-
-        for (size_t i = 0; i < reflectionWords; ++i)
+        if (!wordTerms.empty() && !(x[WIDE_WORDS - 1] >> 63) && QBigNumKernels::normalizedSize(x.data(), WIDE_WORDS) <= k / 32)
         {
-            // Reverse byte order of each word and reflect around the specified point
-            uint64_t word = data[i];
-            word = ((word & 0x00000000000000FFULL) << 56) |
-                   ((word & 0x000000000000FF00ULL) << 40) |
-                   ((word & 0x0000000000FF0000ULL) << 24) |
-                   ((word & 0x00000000FF000000ULL) << 8)  |
-                   ((word & 0x000000FF00000000ULL) >> 8)  |
-                   ((word & 0x0000FF0000000000ULL) >> 24) |
-                   ((word & 0x00FF000000000000ULL) >> 40) |
-                   ((word & 0xFF00000000000000ULL) >> 56);
+            return foldWords(x);
+        }
+        std::array<uint64_t, WIDE_WORDS> high;
+        std::array<uint64_t, WIDE_WORDS + 1> shifted;
+        for (;;)
+        {
+            if (x[WIDE_WORDS - 1] >> 63)
+            {
+                for (uint64_t& word : x)
+                {
+                    word = ~word;
+                }
+                flipped = !flipped;
+            }
+            int xn = QBigNumKernels::normalizedSize(x.data(), WIDE_WORDS);
+            if (xn <= top || (xn == top + 1 && (x[top] & ~lowMask) == 0))
+            {
+                break;
+            }
 
-            // Reflect the word around the specified byte
-            size_t targetWord = (reflectionWords - 1) - i;
-            reversed.data[targetWord] = word;
+            /* high = x >> k, then x = x mod 2^k + sum c (high << e) */
+            int hn = xn - top;
+            for (int i = 0; i < hn; ++i)
+            {
+                high[i] = QBigNumKernels::shiftedRightWord(x.data(), xn, i, top, k % 64);
+            }
+            hn = QBigNumKernels::normalizedSize(high.data(), hn);
+            x[top] &= lowMask;
+            std::fill(x.begin() + top + 1, x.begin() + xn, 0);
+
+            for (const QPair<int, int64_t>& term : terms)
+            {
+                int offset = term.first / 64;
+                int bits = term.first % 64;
+                uint64_t* r = x.data() + offset;
+                int rn = WIDE_WORDS - offset;
+
+                /* The carry out of the top word is never needed, x stays below 2^(64 (WIDE_WORDS - 1)) */
+                const uint64_t* source = high.data();
+                int sn = qMin(hn, rn);
+                if (bits != 0)
+                {
+                    sn = qMin(hn + 1, rn);
+                    for (int i = 0; i < sn; ++i)
+                    {
+                        shifted[i] = QBigNumKernels::shiftedLeftWord(high.data(), hn, i, 0, bits);
+                    }
+                    source = shifted.data();
+                }
+                if (term.second > 0)
+                {
+                    uint64_t carry = QBigNumKernels::addMul1(r, source, sn, uint64_t(term.second));
+                    if (sn < rn)
+                    {
+                        QBigNumKernels::addTo(r + sn, rn - sn, &carry, 1);
+                    }
+                }
+                else
+                {
+                    uint64_t borrow = QBigNumKernels::subMul1(r, source, sn, 0 - uint64_t(term.second));
+                    if (sn < rn)
+                    {
+                        QBigNumKernels::subFrom(r + sn, rn - sn, &borrow, 1);
+                    }
+                }
+            }
         }
 
-        // Copy any remaining bytes (not part of the reflection area)
-        for (size_t i = reflectionWords; i < NUM_WORDS; ++i)
+        /* 0 <= x < 2^k < 2p */
+        QBigNum<Bits> result = subtractModulus(x);
+        if (flipped)
         {
-            reversed.data[i] = data[i];
+            uint64_t one = 1;
+            QBigNumKernels::sub(result.data.data(), m.data.data(), result.data.data(), NUM_WORDS);
+            QBigNumKernels::subFrom(result.data.data(), NUM_WORDS, &one, 1);
         }
+        return result;
+    }
 
-        return reversed;
+    /* x = lo + c hi until x < 2^k. For a product of residues that is two folds, the first leaves less than
+       2^(k + 63) and the second only has a one word hi */
+    QBigNum<Bits> foldPseudoMersenne(std::array<uint64_t, WIDE_WORDS>& x, int top, uint64_t lowMask) const
+    {
+        std::array<uint64_t, WIDE_WORDS> high;
+        int xn = QBigNumKernels::normalizedSize(x.data(), WIDE_WORDS - 1);
+        while (xn > top + 1 || (xn == top + 1 && (x[top] & ~lowMask) != 0))
+        {
+            int hn = xn - top;
+            for (int i = 0; i < hn; ++i)
+            {
+                high[i] = QBigNumKernels::shiftedRightWord(x.data(), xn, i, top, k % 64);
+            }
+            x[top] &= lowMask;
+            std::fill(x.begin() + top + 1, x.begin() + xn, 0);
+
+            __uint128_t sum = 0;
+            int i = 0;
+            for (; i < hn; ++i)
+            {
+                sum += (__uint128_t)high[i] * c + x[i];
+                x[i] = uint64_t(sum);
+                sum >>= 64;
+            }
+            for (; sum != 0 && i < WIDE_WORDS - 1; ++i)
+            {
+                sum += x[i];
+                x[i] = uint64_t(sum);
+                sum >>= 64;
+            }
+            xn = QBigNumKernels::normalizedSize(x.data(), qMax(i, top + 1));
+        }
+        return subtractModulus(x);
     }
 
-    // Set the bit at the specified index
-    void setBit(size_t index)
+    /* Generalised Mersenne reduction, as for the NIST primes. With k and every e_i a multiple of 32 each word
+       2^(32 i) of the high half is congruent to a short signed sum of low words, worked out here once. Returns
+       nothing if a coefficient or a column total reaches 2^29, then one 64 bit column could overflow */
+    std::vector<WordTerm> buildWordTerms() const
     {
-        // Find the word index and the position of the bit in that word
-        size_t wordIndex = index / 64;
-        size_t bitPosition = index % 64;
+        constexpr int64_t limit = int64_t(1) << 29;
+        if (k % 32 != 0)
+        {
+            return {};
+        }
+        for (const QPair<int, int64_t>& term : terms)
+        {
+            if (term.first % 32 != 0 || term.second <= -limit || term.second >= limit)
+            {
+                return {};
+            }
+        }
 
-        // Set the bit at the correct position
-        data[wordIndex] |= (1ULL << bitPosition);
+        int low = k / 32;
+        std::vector<int64_t> columnTotal(low, 1); // the low word itself
+        std::vector<WordTerm> result;
+        for (int i = low; i < 2 * low; ++i)
+        {
+            /* 2^(32 h) == sum c 2^(32 (h - low) + e) for each h >= low, from the top down */
+            std::vector<int64_t> coef(i + 1, 0);
+            coef[i] = 1;
+            for (int h = i; h >= low; --h)
+            {
+                for (const QPair<int, int64_t>& term : terms)
+                {
+                    int64_t& target = coef[h - low + term.first / 32];
+                    target += coef[h] * term.second;
+                    if (target <= -limit || target >= limit)
+                    {
+                        return {};
+                    }
+                }
+                coef[h] = 0;
+            }
+            for (int j = 0; j < low; ++j)
+            {
+                if (coef[j] != 0)
+                {
+                    result.push_back({j, i, coef[j]});
+                    columnTotal[j] += (coef[j] < 0) ? -coef[j] : coef[j];
+                    if (columnTotal[j] >= limit)
+                    {
+                        return {};
+                    }
+                }
+            }
+        }
+        /* Grouped by the low word they land in, so foldWords sums each column in a register */
+        std::stable_sort(result.begin(), result.end(), [](const WordTerm& a, const WordTerm& b) { return a.to < b.to; });
+        return result;
     }
 
-    // Clear the bit at the specified index
-    void clearBit(size_t index)
+    /* 0 <= x < 2^(2k) in a single pass over the words, each column is summed and its carry passed up in
+       one go. What carries out of 2^k is small and folds back through the terms, which takes at most a few
+       rounds */
+    QBigNum<Bits> foldWords(std::array<uint64_t, WIDE_WORDS>& x) const
     {
-        // Find the word index and the position of the bit in that word
-        size_t wordIndex = index / 64;
-        size_t bitPosition = index % 64;
+        int low = k / 32;
+        std::array<int64_t, 4 * NUM_WORDS> words;
+        for (int i = 0; i < 2 * low; ++i)
+        {
+            words[i] = int64_t(uint32_t(x[i >> 1] >> (32 * (i & 1))));
+        }
 
-        // Clear the bit at the correct position
-        data[wordIndex] &= ~(1ULL << bitPosition);
+        /* Column totals stay below 2^61, the high words are only read and the low ones become the result */
+        int64_t high = 0;
+        const WordTerm* term = wordTerms.data();
+        const WordTerm* end = term + wordTerms.size();
+        for (int j = 0; j < low; ++j)
+        {
+            int64_t column = words[j] + high;
+            for (; term != end && term->to == j; ++term)
+            {
+                column += term->coef * words[term->from];
+            }
+            high = column >> 32;
+            words[j] = column & 0xffffffff;
+        }
+        while (high != 0)
+        {
+            for (const QPair<int, int64_t>& term : terms)
+            {
+                words[term.first / 32] += high * term.second;
+            }
+            high = 0;
+            for (int j = 0; j < low; ++j)
+            {
+                words[j] += high;
+                high = words[j] >> 32;
+                words[j] &= 0xffffffff;
+            }
+        }
+
+        /* 0 <= x < 2^k */
+        std::fill(x.begin(), x.end(), 0);
+        for (int j = 0; j < low; ++j)
+        {
+            x[j >> 1] |= uint64_t(words[j]) << (32 * (j & 1));
+        }
+        return subtractModulus(x);
     }
 
+    /* 0 <= x < 2^k from the folds, p > 2^(k-1) so that is at most one subtraction */
+    QBigNum<Bits> subtractModulus(const std::array<uint64_t, WIDE_WORDS>& x) const
+    {
+        QBigNum<Bits> result;
+        std::copy(x.begin(), x.begin() + NUM_WORDS, result.data.begin());
+        if (QBigNumKernels::compare(result.data.data(), m.data.data(), NUM_WORDS) >= 0)
+        {
+            QBigNumKernels::sub(result.data.data(), result.data.data(), m.data.data(), NUM_WORDS);
+        }
+        return result;
+    }
 };
 
 #define DEFINE_NAMESPACE_QBIGNUM(BITS)                              \
@@ -1782,17 +5546,22 @@ namespace QBigNumUtils##BITS                                         \
         BigNum abs(const BigNum& num) { return BigNum::abs(num); } \
         BigNum abs(const QString& num) { return BigNum::abs(num); } \
                                                                      \
-        BigNum legendre(const BigNum& a, const BigNum& p) { return BigNum::legendre(a, p); } \
-        BigNum legendre(const QString& a, const QString& p) { return BigNum::legendre(a, p); } \
-        BigNum legendre(int64_t a, int64_t p) { return BigNum::legendre(a, p); } \
+        int legendre(const BigNum& a, const BigNum& p) { return BigNum::legendre(a, p); } \
+        int legendre(const QString& a, const QString& p) { return BigNum::legendre(a, p); } \
+        int legendre(int64_t a, int64_t p) { return BigNum::legendre(a, p); } \
+        int jacobi(const BigNum& a, const BigNum& n) { return BigNum::jacobi(a, n); } \
+        int jacobi(const QString& a, const QString& n) { return BigNum::jacobi(a, n); } \
+        int jacobi(int64_t a, int64_t n) { return BigNum::jacobi(a, n); } \
                                                                      \
         BigNum mulMod(const BigNum& a, const BigNum& b, const BigNum& mod) { return BigNum::mulMod(a, b, mod); }           \
         BigNum mulMod(const QString& a, const QString& b, const QString& mod) { return BigNum::mulMod(a, b, mod); }           \
         BigNum mulMod(int64_t a, int64_t b, int64_t mod) { return BigNum::mulMod(a, b, mod); }           \
+        BigNum sqrMod(const BigNum& a, const BigNum& mod) { return BigNum::sqrMod(a, mod); }           \
                                                                     \
         BigNum powMod(const BigNum& base, const BigNum& exp, const BigNum& mod) { return BigNum::powMod(base, exp, mod); }           \
         BigNum powMod(const QString& base, const QString& exp, const QString& mod) { return BigNum::powMod(base, exp, mod); }           \
         BigNum powMod(int64_t base, int64_t exp, int64_t mod) { return BigNum::powMod(base, exp, mod); }           \
+        BigNum multiPowMod(const QList<BigNum>& bases, const QList<BigNum>& exps, const BigNum& mod) { return BigNum::multiPowMod(bases, exps, mod); } \
                                                                     \
         BigNum gcd(const BigNum& a, const BigNum& b) { return BigNum::gcd(a, b); } \
         BigNum gcd(const QString& a, const QString& b) { return BigNum::gcd(a, b); } \
@@ -1815,6 +5584,20 @@ typedef QBigNum<BITS> QBigNum##BITS
     DEFINE_NAMESPACE_QBIGNUM(BITS); \
     using namespace QBigNumUtils##BITS
 
-typedef QBigNum<256> QBigNum256;
-typedef QBigNum<512> QBigNum512;
-typedef QBigNum<1024> QBigNum1024;
+/* User-defined literal built at compile time, e.g. "using namespace QBigNumLiterals; auto p = 0x7fffffed_bn512;" */
+#define DEFINE_QBIGNUM_LITERAL(BITS)                                 \
+namespace QBigNumLiterals                                            \
+{                                                                    \
+        template <char... Chars>                                     \
+        constexpr QBigNum<BITS> operator"" _bn##BITS()               \
+        {                                                            \
+            return QBigNum<BITS>::template literal<Chars...>();      \
+        }                                                            \
+} \
+typedef QBigNum<BITS> QBigNum##BITS
+
+DEFINE_QBIGNUM_LITERAL(256);
+DEFINE_QBIGNUM_LITERAL(512);
+DEFINE_QBIGNUM_LITERAL(1024);
+
+static_assert(std::is_trivially_copyable<QBigNum512>::value, "QBigNum should be trivially copyable");
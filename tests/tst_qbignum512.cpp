@@ -3,6 +3,27 @@
 #include <QElapsedTimer>
 #include "../qbignum.hpp"
 
+/* Drop the NTT threshold for one width so testNtt can reach it through the public API at a testable size */
+template <>
+struct QBigNumThresholds<65536>
+{
+    static constexpr int karatsuba = QBIGNUM_KARATSUBA_THRESHOLD;
+    static constexpr int toom3 = QBIGNUM_TOOM3_THRESHOLD;
+    static constexpr int ntt = 256;
+};
+
+/* Likewise drop the half gcd thresholds so testHalfGcd runs the recursion on a few dozen words. The width is
+   used by nothing else, so the other QBigNum<4096> tests keep the default thresholds */
+template <>
+struct QBigNumThresholds<4160>
+{
+    static constexpr int karatsuba = 4;
+    static constexpr int toom3 = 12;
+    static constexpr int ntt = QBIGNUM_NTT_THRESHOLD;
+    static constexpr int hgcd = 8;
+    static constexpr int hgcdInverse = 8;
+};
+
 class TestQBigNum512 : public QObject
 {
     Q_OBJECT
@@ -11,6 +32,7 @@ private slots:
     void testDefaultConstructor();
     void testConstructorWithValue();
     void testConstructorWithHex();
+    void testLiteral();
     void testAssignment();
     void testToHex();
     void testIncrement();
@@ -22,20 +44,39 @@ private slots:
     void testSubtractionByScalar();
     void testMultiplicationByScalar();
     void testMultiplication();
+    void testAddMul();
+    void testMulKernels();
+    void testMulWide();
+    void testSqr();
+    void testKaratsuba();
+    void testToom3();
+    void testNtt();
     void testLeftShift();
     void testRightShift();
     void testShiftLeft();
     void testComparisonOperators();
+    void testUnrolledWidths();
     void testToDecimal();
     void testFromDecimal();
     void testDevision();
     void testModulo();
+    void testScalarDivision();
     void testPowMod();
+    void testBarrett();
+    void testMontgomery();
+    void testMultiPowMod();
+    void testFixedBase();
+    void testSpecialModulus();
     void testInverseMod();
+    void testBatchInverseMod();
     void testDivisionWithGMP();
     void testDivisionSpeedWithGMP();
     void testGCD();
+    void testHalfGcd();
+    void testPowModSpeed();
+    void testMulCrossover();
     void testMillerRabin();
+    void testJacobi();
     void testTonelli();
 };
 
@@ -108,6 +149,28 @@ void TestQBigNum512::testConstructorWithHex()
     QVERIFY(num == QBigNum512::fromHex("0x123456789ABCDEF"));
 }
 
+void TestQBigNum512::testLiteral()
+{
+    using namespace QBigNumLiterals;
+
+    constexpr QBigNum512 hex = 0x7fffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffed_bn512;
+    QCOMPARE(hex, QBigNum512::fromHex("0x7fffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffed"));
+
+    constexpr QBigNum512 dec = 5434567897765443456789876756432456789897675453345678976545342345678_bn512;
+    QCOMPARE(dec, QBigNum512::fromDecimal("5434567897765443456789876756432456789897675453345678976545342345678"));
+
+    QCOMPARE(0b1011'0000_bn512, QBigNum512(176));
+    QCOMPARE(1'000'000_bn512, QBigNum512(1000000));
+    QCOMPARE(-42_bn512, QBigNum512(-42));
+
+    constexpr QBigNum512 minusOne = -1;
+    static_assert(minusOne < 0 && minusOne.bitLength() == 1, "constexpr QBigNum");
+    static_assert((QBigNum512(1) << 100) > (QBigNum512(1) << 99), "constexpr QBigNum");
+
+    QVERIFY_THROWS_EXCEPTION(std::overflow_error, QBigNum256::fromLiteral("0x8000000000000000000000000000000000000000000000000000000000000000", 66));
+    QVERIFY_THROWS_EXCEPTION(std::invalid_argument, QBigNum256::fromLiteral("12a", 3));
+}
+
 void TestQBigNum512::testAssignment()
 {
     QBigNum512 num;
@@ -123,6 +186,41 @@ void TestQBigNum512::testToHex()
     QVERIFY(num.toHexString() == QString("0x1234564756474536543645863475636566745575478635648653685856789ABCDEF").toLower());
 }
 
+template <size_t Bits>
+static void checkAgainstLooped()
+{
+    /* QBigNum<4096> is past QBIGNUM_UNROLL_WORDS so it takes the loop path */
+    for (int k = 0; k < 200; k++)
+    {
+        QBigNum<Bits> a = QBigNum<Bits>::randomize(QRandomGenerator::global()->bounded(Bits / 2) + 1, QRandomGenerator::global()->generate() & 1);
+        QBigNum<Bits> b = QBigNum<Bits>::randomize(QRandomGenerator::global()->bounded(Bits / 2) + 1, QRandomGenerator::global()->generate() & 1);
+        QBigNum<4096> bigA = QBigNum<4096>::fromHex(a.toHexString());
+        QBigNum<4096> bigB = QBigNum<4096>::fromHex(b.toHexString());
+        int shift = QRandomGenerator::global()->bounded(Bits / 2);
+
+        QCOMPARE((a + b).toHexString(), (bigA + bigB).toHexString());
+        QCOMPARE((a - b).toHexString(), (bigA - bigB).toHexString());
+        QCOMPARE((a * 12345).toHexString(), (bigA * 12345).toHexString());
+        QBigNum<Bits> absA = QBigNum<Bits>::abs(a);
+        QCOMPARE(absA >> shift, QBigNum<Bits>::fromHex((QBigNum<4096>::abs(bigA) >> shift).toHexString()));
+        QCOMPARE(absA << shift >> shift, absA);
+        QCOMPARE(a < b, bigA < bigB);
+        QCOMPARE(a >= b, bigA >= bigB);
+        QCOMPARE(a == b, bigA == bigB);
+        QVERIFY(a == a && !(a != a) && a <= a && a >= a);
+    }
+    QCOMPARE(QBigNum<Bits>(1) << (Bits - 1) >> (Bits - 1), QBigNum<Bits>(1));
+    QCOMPARE(QBigNum<Bits>(-1) << Bits, QBigNum<Bits>(0));
+}
+
+void TestQBigNum512::testUnrolledWidths()
+{
+    checkAgainstLooped<256>();
+    checkAgainstLooped<320>();
+    checkAgainstLooped<512>();
+    checkAgainstLooped<1024>();
+}
+
 void TestQBigNum512::testToDecimal()
 {
 
@@ -156,6 +254,12 @@ void TestQBigNum512::testFromDecimal()
 
     QVERIFY_THROWS_EXCEPTION(std::overflow_error, QBigNum512("456666666666666666666666456677852384757849873289674295687349568734098567340862387456203784598374598374598237459827349587239485732948572398475329847529384572039845"));
     QVERIFY_THROWS_EXCEPTION(std::overflow_error, QBigNum512("-456666666666666666666666456677852384757849873289674295687349568734098567340862387456203784598374598374598237459827349587239485732948572398475329847529384572039845"));
+
+    /* Largest value and the first values that don't fit */
+    QCOMPARE(QBigNum512::fromDecimal(QBigNum512::max().toDecimalString()), QBigNum512::max());
+    QVERIFY_THROWS_EXCEPTION(std::overflow_error, QBigNum512("6703903964971298549787012499102923063739682910296196688861780721860882015036773488400937149083451713845015929093243025426876941405973284973216824503042048"));
+    QVERIFY_THROWS_EXCEPTION(std::overflow_error, QBigNum512("13407807929942597099574024998205846127479365820592393377723561443721764030073546976801874298166903427690031858186486050853753882811946569946433649006084101"));
+    QCOMPARE(QBigNum512("000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000012"), 12);
 }
 
 void TestQBigNum512::testIncrement()
@@ -487,6 +591,341 @@ void TestQBigNum512::testMultiplication()
     QVERIFY(b*a == "1516862968555507041076172169562208670475462971027051");
 }
 
+void TestQBigNum512::testAddMul()
+{
+    QBigNum512 a, b, c, expected;
+    a = "1231654654654541321564654654131";
+    b = "-1231565165465121321321";
+    c = "7567456456456745674567456745674567";
+
+    expected = a + b * c;
+    QBigNum512::addMul(a, b, c);
+    QCOMPARE(a, expected);
+
+    expected = a - b * c;
+    QBigNum512::subMul(a, b, c);
+    QCOMPARE(a, expected);
+
+    expected = a + b * 0x7fffffffffffffffLL;
+    QBigNum512::addMul1(a, b, 0x7fffffffffffffffULL);
+    QCOMPARE(a, expected);
+
+    expected = a - c * 12345;
+    QBigNum512::subMul1(a, c, 12345);
+    QCOMPARE(a, expected);
+
+    for (int k = 0; k < 1000; k++)
+    {
+        a = QBigNum512::randomize(511, QRandomGenerator::global()->generate() & 1);
+        b = QBigNum512::randomize(QRandomGenerator::global()->bounded(511) + 1, QRandomGenerator::global()->generate() & 1);
+        c = QBigNum512::randomize(QRandomGenerator::global()->bounded(511) + 1, QRandomGenerator::global()->generate() & 1);
+        uint64_t d = QRandomGenerator::global()->generate64();
+
+        expected = a + b * c;
+        QBigNum512 result = a;
+        QBigNum512::addMul(result, b, c);
+        QCOMPARE(result, expected);
+
+        expected = a - b * c;
+        result = a;
+        QBigNum512::subMul(result, b, c);
+        QCOMPARE(result, expected);
+
+        expected = a + b * QBigNum512::fromHex(QBigNum512::UInt64ToHexString(d));
+        result = a;
+        QBigNum512::addMul1(result, b, d);
+        QCOMPARE(result, expected);
+
+        expected = a - b * QBigNum512::fromHex(QBigNum512::UInt64ToHexString(d));
+        result = a;
+        QBigNum512::subMul1(result, b, d);
+        QCOMPARE(result, expected);
+    }
+}
+
+void TestQBigNum512::testMulKernels()
+{
+    /* The dispatching kernels run the mulx/adcx/adox code on CPUs that have it, check them against the portable ones */
+    std::array<uint64_t, 40> a, expected, result, m;
+    std::array<uint64_t, 80> t;
+    for (int k = 0; k < 2000; k++)
+    {
+        int n = QRandomGenerator::global()->bounded(40) + 1;
+        uint64_t b = (k % 3 == 0) ? ~0ULL : QRandomGenerator::global()->generate64();
+        uint64_t c = QRandomGenerator::global()->generate64();
+        for (int i = 0; i < n; i++)
+        {
+            a[i] = (k % 5 == 0) ? ~0ULL : QRandomGenerator::global()->generate64();
+            expected[i] = result[i] = (k % 7 == 0) ? ~0ULL : QRandomGenerator::global()->generate64();
+        }
+        QCOMPARE(QBigNumKernels::addMul1(result.data(), a.data(), n, b), QBigNumKernels::addMul1Portable(expected.data(), a.data(), n, b));
+        QVERIFY(std::equal(expected.begin(), expected.begin() + n, result.begin()));
+        QCOMPARE(QBigNumKernels::mul1(result.data(), a.data(), n, b, c), QBigNumKernels::mul1Portable(expected.data(), a.data(), n, b, c));
+        QVERIFY(std::equal(expected.begin(), expected.begin() + n, result.begin()));
+        QCOMPARE(QBigNumKernels::mul1(result.data(), result.data(), n, b), QBigNumKernels::mul1Portable(expected.data(), expected.data(), n, b));
+        QVERIFY(std::equal(expected.begin(), expected.begin() + n, result.begin()));
+    }
+
+    /* montgomeryReduce gives t / 2^(64n) mod m, so result * 2^(64n) == t mod m */
+    mpz_t gmp_t, gmp_m, gmp_r;
+    mpz_inits(gmp_t, gmp_m, gmp_r, nullptr);
+    for (int k = 0; k < 500; k++)
+    {
+        int n = QRandomGenerator::global()->bounded(40) + 1;
+        for (int i = 0; i < n; i++)
+        {
+            m[i] = (k % 5 == 0) ? ~0ULL : QRandomGenerator::global()->generate64();
+            t[i] = QRandomGenerator::global()->generate64();
+            t[n + i] = (k % 7 == 0) ? m[i] : QRandomGenerator::global()->generate64();
+        }
+        m[0] |= 1;
+        m[n - 1] |= 1ULL << 63;
+        if (QBigNumKernels::compare(t.data() + n, m.data(), n) >= 0)
+        {
+            QBigNumKernels::sub(t.data() + n, t.data() + n, m.data(), n);
+        }
+
+        uint64_t mInv = m[0];
+        for (int i = 0; i < 5; i++)
+        {
+            mInv *= 2 - m[0] * mInv;
+        }
+        mpz_import(gmp_t, 2 * n, -1, sizeof(uint64_t), 0, 0, t.data());
+        mpz_import(gmp_m, n, -1, sizeof(uint64_t), 0, 0, m.data());
+        QBigNumKernels::montgomeryReduce(result.data(), t.data(), m.data(), n, 0 - mInv);
+
+        mpz_import(gmp_r, n, -1, sizeof(uint64_t), 0, 0, result.data());
+        QVERIFY(mpz_cmp(gmp_r, gmp_m) < 0);
+        mpz_mul_2exp(gmp_r, gmp_r, 64 * n);
+        mpz_sub(gmp_r, gmp_r, gmp_t);
+        QVERIFY(mpz_divisible_p(gmp_r, gmp_m));
+    }
+    mpz_clears(gmp_t, gmp_m, gmp_r, nullptr);
+}
+
+void TestQBigNum512::testMulWide()
+{
+    mpz_t gmp_a, gmp_b, gmp_p;
+    mpz_inits(gmp_a, gmp_b, gmp_p, nullptr);
+
+    QBigNum512 max = QBigNum512::max();
+    QBigNum512 min = QBigNum512::min();
+    QCOMPARE(QBigNum512::mulWide(max, max), QBigNum1024(max.toDecimalString()) * QBigNum1024(max.toDecimalString()));
+    QCOMPARE(QBigNum512::mulWide(min, min), QBigNum1024(1) << 1022);
+    QCOMPARE(QBigNum512::mulWide(min, 3), QBigNum1024(-3) << 511);
+    QCOMPARE(QBigNum512::mulHigh(QBigNum512(1) << 300, QBigNum512(1) << 300), QBigNum512(1) << 88);
+    QCOMPARE(QBigNum512::mulHigh(-1, 1), -1);
+    QCOMPARE(QBigNum512::mulHigh(0, -1), 0);
+
+    for (int k = 0; k < 1000; k++)
+    {
+        QBigNum512 a = QBigNum512::randomize(QRandomGenerator::global()->bounded(511) + 1, QRandomGenerator::global()->generate() & 1);
+        QBigNum512 b = QBigNum512::randomize(QRandomGenerator::global()->bounded(511) + 1, QRandomGenerator::global()->generate() & 1);
+
+        mpz_set_str(gmp_a, a.toDecimalString().toStdString().c_str(), 10);
+        mpz_set_str(gmp_b, b.toDecimalString().toStdString().c_str(), 10);
+        mpz_mul(gmp_p, gmp_a, gmp_b);
+        QCOMPARE(QBigNum512::mulWide(a, b).toDecimalString(), QString(mpz_get_str(nullptr, 10, gmp_p)));
+
+        mpz_fdiv_q_2exp(gmp_p, gmp_p, 512);
+        QCOMPARE(QBigNum512::mulHigh(a, b).toDecimalString(), QString(mpz_get_str(nullptr, 10, gmp_p)));
+    }
+
+    mpz_clears(gmp_a, gmp_b, gmp_p, nullptr);
+}
+
+void TestQBigNum512::testSqr()
+{
+    QCOMPARE(QBigNum512::sqrWide(0), 0);
+    QCOMPARE(QBigNum512::sqrWide(-3), 9);
+    QCOMPARE(QBigNum512::sqrWide(QBigNum512::min()), QBigNum1024(1) << 1022);
+    QCOMPARE(QBigNum512::sqrWide(QBigNum512::max()), QBigNum512::mulWide(QBigNum512::max(), QBigNum512::max()));
+    QCOMPARE(QBigNum512::sqrMod(-10, 7), 2);
+    QCOMPARE(QBigNum512::sqrMod(-10, -7), -5);
+
+    for (int k = 0; k < 1000; k++)
+    {
+        QBigNum512 a = QBigNum512::randomize(QRandomGenerator::global()->bounded(511) + 1, QRandomGenerator::global()->generate() & 1);
+        QBigNum512 m = QBigNum512::randomize(QRandomGenerator::global()->bounded(511) + 1, QRandomGenerator::global()->generate() & 1);
+        QCOMPARE(QBigNum512::sqrWide(a), QBigNum512::mulWide(a, a));
+        if (m != 0)
+        {
+            QCOMPARE(QBigNum512::sqrMod(a, m), QBigNum512::mulMod(a, a, m));
+        }
+    }
+}
+
+void TestQBigNum512::testKaratsuba()
+{
+    constexpr int maxWords = 96;
+    std::array<uint64_t, maxWords> a, b;
+    std::array<uint64_t, 2 * maxWords> expected, result;
+    std::array<uint64_t, QBigNumKernels::mulScratchSize(maxWords)> scratch;
+    constexpr QBigNumKernels::MulThresholds karatsubaOnly{2, std::numeric_limits<int>::max()};
+
+    for (int n : {2, 3, 5, 8, 17, 31, 64, 96})
+    {
+        for (int k = 0; k < 20; k++)
+        {
+            for (int i = 0; i < n; i++)
+            {
+                /* Mix in all ones words to push the carry paths */
+                a[i] = (k & 1) ? ~0ULL : QRandomGenerator::global()->generate64();
+                b[i] = (k & 2) ? ~0ULL : QRandomGenerator::global()->generate64();
+            }
+            int an = QRandomGenerator::global()->bounded(n) + 1;
+
+            QBigNumKernels::mulSchoolbook(expected.data(), a.data(), n, b.data(), n);
+            QBigNumKernels::mulKaratsuba(result.data(), a.data(), b.data(), n, scratch.data(), karatsubaOnly);
+            QVERIFY(std::equal(expected.begin(), expected.begin() + 2 * n, result.begin()));
+
+            QBigNumKernels::sqrSchoolbook(expected.data(), a.data(), n);
+            QBigNumKernels::sqrKaratsuba(result.data(), a.data(), n, scratch.data(), karatsubaOnly);
+            QVERIFY(std::equal(expected.begin(), expected.begin() + 2 * n, result.begin()));
+
+            QBigNumKernels::mulSchoolbook(expected.data(), a.data(), an, b.data(), n);
+            QBigNumKernels::mul(result.data(), a.data(), an, b.data(), n, scratch.data(), karatsubaOnly);
+            QVERIFY(std::equal(expected.begin(), expected.begin() + an + n, result.begin()));
+        }
+    }
+
+    mpz_t gmp_a, gmp_b, gmp_p;
+    mpz_inits(gmp_a, gmp_b, gmp_p, nullptr);
+
+    for (int k = 0; k < 50; k++)
+    {
+        QBigNum<4096> x = QBigNum<4096>::randomize(QRandomGenerator::global()->bounded(4095) + 1, QRandomGenerator::global()->generate() & 1);
+        QBigNum<4096> y = QBigNum<4096>::randomize(QRandomGenerator::global()->bounded(4095) + 1, QRandomGenerator::global()->generate() & 1);
+
+        /* Hex keeps the conversions cheap at this width */
+        mpz_set_str(gmp_a, x.toHexString().toStdString().c_str(), 0);
+        mpz_set_str(gmp_b, y.toHexString().toStdString().c_str(), 0);
+        mpz_mul(gmp_p, gmp_a, gmp_b);
+        QCOMPARE(QBigNum<4096>::mulWide(x, y), QBigNum<8192>::fromHex(mpz_get_str(nullptr, 16, gmp_p)));
+        QCOMPARE(QBigNum<4096>::sqrWide(x), QBigNum<4096>::mulWide(x, x));
+
+        /* operator* wraps, so compare against the product mod 2^4096 in two's complement */
+        mpz_fdiv_r_2exp(gmp_p, gmp_p, 4096);
+        if (mpz_tstbit(gmp_p, 4095))
+        {
+            mpz_ui_pow_ui(gmp_a, 2, 4096);
+            mpz_sub(gmp_p, gmp_p, gmp_a);
+        }
+        QCOMPARE(x * y, QBigNum<4096>::fromHex(mpz_get_str(nullptr, 16, gmp_p)));
+    }
+
+    mpz_clears(gmp_a, gmp_b, gmp_p, nullptr);
+}
+
+void TestQBigNum512::testToom3()
+{
+    constexpr int maxWords = 160;
+    std::array<uint64_t, maxWords> a, b;
+    std::array<uint64_t, 2 * maxWords> expected, result;
+    std::array<uint64_t, QBigNumKernels::mulScratchSize(maxWords)> scratch;
+    constexpr QBigNumKernels::MulThresholds toomOnly{2, 5};
+
+    for (int n : {5, 6, 7, 9, 16, 29, 81, 100, 160})
+    {
+        for (int k = 0; k < 20; k++)
+        {
+            for (int i = 0; i < n; i++)
+            {
+                a[i] = (k & 1) ? ~0ULL : QRandomGenerator::global()->generate64();
+                b[i] = (k & 2) ? ~0ULL : QRandomGenerator::global()->generate64();
+            }
+            int an = QRandomGenerator::global()->bounded(n) + 1;
+
+            QBigNumKernels::mulSchoolbook(expected.data(), a.data(), n, b.data(), n);
+            QBigNumKernels::mulToom3(result.data(), a.data(), b.data(), n, scratch.data(), toomOnly);
+            QVERIFY(std::equal(expected.begin(), expected.begin() + 2 * n, result.begin()));
+
+            QBigNumKernels::sqrSchoolbook(expected.data(), a.data(), n);
+            QBigNumKernels::sqrToom3(result.data(), a.data(), n, scratch.data(), toomOnly);
+            QVERIFY(std::equal(expected.begin(), expected.begin() + 2 * n, result.begin()));
+
+            QBigNumKernels::mulSchoolbook(expected.data(), a.data(), an, b.data(), n);
+            QBigNumKernels::mul(result.data(), a.data(), an, b.data(), n, scratch.data(), toomOnly);
+            QVERIFY(std::equal(expected.begin(), expected.begin() + an + n, result.begin()));
+        }
+    }
+
+    mpz_t gmp_a, gmp_b, gmp_p;
+    mpz_inits(gmp_a, gmp_b, gmp_p, nullptr);
+
+    for (int k = 0; k < 10; k++)
+    {
+        QBigNum<16384> x = QBigNum<16384>::randomize(QRandomGenerator::global()->bounded(16383) + 1, QRandomGenerator::global()->generate() & 1);
+        QBigNum<16384> y = QBigNum<16384>::randomize(QRandomGenerator::global()->bounded(16383) + 1, QRandomGenerator::global()->generate() & 1);
+
+        mpz_set_str(gmp_a, x.toHexString().toStdString().c_str(), 0);
+        mpz_set_str(gmp_b, y.toHexString().toStdString().c_str(), 0);
+        mpz_mul(gmp_p, gmp_a, gmp_b);
+        QCOMPARE(QBigNum<16384>::mulWide(x, y), QBigNum<32768>::fromHex(mpz_get_str(nullptr, 16, gmp_p)));
+        QCOMPARE(QBigNum<16384>::sqrWide(x), QBigNum<16384>::mulWide(x, x));
+    }
+
+    mpz_clears(gmp_a, gmp_b, gmp_p, nullptr);
+}
+
+void TestQBigNum512::testNtt()
+{
+    constexpr int maxWords = 1500;
+    std::vector<uint64_t> a(maxWords), b(maxWords), expected(2 * maxWords), result(2 * maxWords);
+    std::vector<uint64_t> scratch(QBigNumKernels::mulScratchSize(maxWords));
+
+    for (int n : {1, 2, 3, 7, 64, 100, 513, 1500})
+    {
+        for (int k = 0; k < 4; k++)
+        {
+            for (int i = 0; i < n; i++)
+            {
+                /* All ones words give the largest convolution coefficients */
+                a[i] = (k & 1) ? ~0ULL : QRandomGenerator::global()->generate64();
+                b[i] = (k & 2) ? ~0ULL : QRandomGenerator::global()->generate64();
+            }
+            int an = QRandomGenerator::global()->bounded(n) + 1;
+
+            QBigNumKernels::mulBalanced(expected.data(), a.data(), b.data(), n, scratch.data(), {QBIGNUM_KARATSUBA_THRESHOLD, QBIGNUM_TOOM3_THRESHOLD});
+            QBigNumKernels::mulNtt(result.data(), a.data(), n, b.data(), n);
+            QVERIFY(std::equal(expected.begin(), expected.begin() + 2 * n, result.begin()));
+
+            QBigNumKernels::mulNtt(result.data(), a.data(), n, a.data(), n);
+            QBigNumKernels::sqrBalanced(expected.data(), a.data(), n, scratch.data(), {QBIGNUM_KARATSUBA_THRESHOLD, QBIGNUM_TOOM3_THRESHOLD});
+            QVERIFY(std::equal(expected.begin(), expected.begin() + 2 * n, result.begin()));
+
+            QBigNumKernels::mulSchoolbook(expected.data(), a.data(), an, b.data(), n);
+            QBigNumKernels::mulNtt(result.data(), a.data(), an, b.data(), n);
+            QVERIFY(std::equal(expected.begin(), expected.begin() + an + n, result.begin()));
+        }
+    }
+
+    mpz_t gmp_a, gmp_b, gmp_p;
+    mpz_inits(gmp_a, gmp_b, gmp_p, nullptr);
+
+    for (int k = 0; k < 4; k++)
+    {
+        QBigNum<65536> x = QBigNum<65536>::randomize(QRandomGenerator::global()->bounded(65535) + 1, QRandomGenerator::global()->generate() & 1);
+        QBigNum<65536> y = QBigNum<65536>::randomize(QRandomGenerator::global()->bounded(65535) + 1, QRandomGenerator::global()->generate() & 1);
+
+        mpz_set_str(gmp_a, x.toHexString().toStdString().c_str(), 0);
+        mpz_set_str(gmp_b, y.toHexString().toStdString().c_str(), 0);
+        mpz_mul(gmp_p, gmp_a, gmp_b);
+        QCOMPARE(QBigNum<65536>::mulWide(x, y), QBigNum<131072>::fromHex(mpz_get_str(nullptr, 16, gmp_p)));
+        QCOMPARE(QBigNum<65536>::sqrWide(x), QBigNum<65536>::mulWide(x, x));
+
+        mpz_fdiv_r_2exp(gmp_p, gmp_p, 65536);
+        if (mpz_tstbit(gmp_p, 65535))
+        {
+            mpz_ui_pow_ui(gmp_a, 2, 65536);
+            mpz_sub(gmp_p, gmp_p, gmp_a);
+        }
+        QCOMPARE(x * y, QBigNum<65536>::fromHex(mpz_get_str(nullptr, 16, gmp_p)));
+    }
+
+    mpz_clears(gmp_a, gmp_b, gmp_p, nullptr);
+}
+
 void TestQBigNum512::testShiftLeft()
 {
     QBigNum512 num(1);
@@ -769,7 +1208,28 @@ void TestQBigNum512::testModulo()
         auto result = a % m;
 
         QCOMPARE(result, r);
+
+        /* Exact multiples and the in place and aliased forms */
+        QCOMPARE((q * m) % m, 0);
+        QBigNum512 b = a;
+        b %= m;
+        QCOMPARE(b, r);
+        b = m;
+        b %= b;
+        QCOMPARE(b, 0);
     }
+
+    /* Sign combinations, the remainder follows the divisor */
+    QCOMPARE(QBigNum512(7) % QBigNum512(-3), -2);
+    QCOMPARE(QBigNum512(-7) % QBigNum512(-3), -1);
+    QCOMPARE(QBigNum512(-7) % QBigNum512(3), 2);
+    QCOMPARE(QBigNum512(-6) % QBigNum512(3), 0);
+    QCOMPARE(QBigNum512(2) % QBigNum512(-3), -1);
+    QCOMPARE(QBigNum512::min() % QBigNum512(3), QBigNum512::min() - (QBigNum512::min() / QBigNum512(3)).first * 3);
+    QCOMPARE(QBigNum512::min() % QBigNum512::min(), 0);
+    QCOMPARE(QBigNum512(-1) % QBigNum512::min(), -1);
+    QCOMPARE(QBigNum512(1) % QBigNum512::min(), QBigNum512::min() + 1);
+    QCOMPARE(QBigNum512::min() % QBigNum512::max(), QBigNum512::max() - 1);
 }
 
 void TestQBigNum512::testDivisionWithGMP()
@@ -807,6 +1267,59 @@ void TestQBigNum512::testDivisionWithGMP()
         QCOMPARE(r.toDecimalString(), QString(mpz_get_str(nullptr, 10, gmp_r)));
     }
 
+    /* Random sizes and signs, plus words of all ones and a bare top bit which push the quotient
+       estimate into its correction and add back paths */
+    for (int k = 0; k < 3000; k++)
+    {
+        QBigNum512 a = QBigNum512::randomize(QRandomGenerator::global()->bounded(511) + 1, QRandomGenerator::global()->generate() & 1);
+        QBigNum512 b = QBigNum512::randomize(QRandomGenerator::global()->bounded(511) + 1, QRandomGenerator::global()->generate() & 1);
+        if (k % 4 == 1)
+        {
+            int words = QRandomGenerator::global()->bounded(7) + 1;
+            a = (QBigNum512(1) << (64 * words + 63)) - 1;
+            b = (QBigNum512(1) << (64 * QRandomGenerator::global()->bounded(words) + 63)) + QRandomGenerator::global()->bounded(3);
+        }
+        else if (k % 4 == 2)
+        {
+            b = (QBigNum512(1) << (64 * QRandomGenerator::global()->bounded(7) + 63)) - QBigNum512::randomize(64, false);
+        }
+        if (b == 0)
+        {
+            continue;
+        }
+
+        mpz_set_str(gmp_a, a.toDecimalString().toStdString().c_str(), 10);
+        mpz_set_str(gmp_b, b.toDecimalString().toStdString().c_str(), 10);
+        mpz_fdiv_qr(gmp_q, gmp_r, gmp_a, gmp_b);
+
+        auto [q, r] = a / b;
+        QCOMPARE(q.toDecimalString(), QString(mpz_get_str(nullptr, 10, gmp_q)));
+        QCOMPARE(r.toDecimalString(), QString(mpz_get_str(nullptr, 10, gmp_r)));
+    }
+
+    /* Single word divisors take the 2 by 1 reciprocal path */
+    for (int k = 0; k < 1000; k++)
+    {
+        QBigNum512 a = QBigNum512::randomize(QRandomGenerator::global()->bounded(511) + 1, QRandomGenerator::global()->generate() & 1);
+        QBigNum512 b = QBigNum512::randomize(QRandomGenerator::global()->bounded(64) + 1, QRandomGenerator::global()->generate() & 1);
+        if (b == 0)
+        {
+            continue;
+        }
+
+        mpz_set_str(gmp_a, a.toDecimalString().toStdString().c_str(), 10);
+        mpz_set_str(gmp_b, b.toDecimalString().toStdString().c_str(), 10);
+        mpz_fdiv_qr(gmp_q, gmp_r, gmp_a, gmp_b);
+
+        auto [q, r] = a / b;
+        QCOMPARE(q.toDecimalString(), QString(mpz_get_str(nullptr, 10, gmp_q)));
+        QCOMPARE(r.toDecimalString(), QString(mpz_get_str(nullptr, 10, gmp_r)));
+    }
+
+    QCOMPARE((QBigNum512::min() / 1).first, QBigNum512::min());
+    QCOMPARE((QBigNum512::min() / QBigNum512::min()).first, 1);
+    QCOMPARE((QBigNum512::min() / -1).second, 0);
+
     // Clear GMP variables
     mpz_clears(gmp_q, gmp_r, gmp_a, gmp_b, nullptr);
 }
@@ -928,6 +1441,74 @@ void TestQBigNum512::testDivisionSpeedWithGMP()
     mpz_clears(gmp_a, gmp_b, gmp_q, gmp_r, nullptr);
 }
 
+void TestQBigNum512::testScalarDivision()
+{
+    mpz_t gmp_a, gmp_b, gmp_q, gmp_r;
+    mpz_inits(gmp_a, gmp_b, gmp_q, gmp_r, nullptr);
+    auto fromGmp = [](const mpz_t x) { return QBigNum512::fromHex(mpz_get_str(nullptr, 16, x)); };
+
+    QList<int64_t> scalars = {1, -1, 2, -2, 3, 7, -10, 8, -8, 1LL << 62, -(1LL << 62), std::numeric_limits<int64_t>::max(),
+                              std::numeric_limits<int64_t>::min()};
+    for (int k = 0; k < 20; k++)
+    {
+        int64_t scalar = static_cast<int64_t>(QRandomGenerator::global()->generate64() >> QRandomGenerator::global()->bounded(64));
+        scalars.append((k & 1) ? -scalar : scalar);
+    }
+
+    for (int64_t scalar : scalars)
+    {
+        if (scalar == 0)
+        {
+            continue;
+        }
+        for (int k = 0; k < 50; k++)
+        {
+            QBigNum512 a = QBigNum512::randomize(QRandomGenerator::global()->bounded(511) + 1, QRandomGenerator::global()->generate() & 1);
+            if (k == 0)
+            {
+                a = QBigNum512::min();
+            }
+
+            /* min() / -1 overflows and fromHex cannot parse min() itself */
+            if (k == 0 && (scalar == 1 || scalar == -1))
+            {
+                continue;
+            }
+
+            mpz_set_str(gmp_a, a.toHexString().toStdString().c_str(), 0);
+            mpz_set_si(gmp_b, scalar);
+            mpz_fdiv_qr(gmp_q, gmp_r, gmp_a, gmp_b);
+            QBigNum512 expectedQ = fromGmp(gmp_q);
+            QBigNum512 expectedR = fromGmp(gmp_r);
+
+            auto [q, r] = a / scalar;
+            QCOMPARE(q, expectedQ);
+            QCOMPARE(r, expectedR);
+            QCOMPARE(a % scalar, expectedR);
+            QCOMPARE(a.div(scalar), expectedQ);
+
+            QBigNum512 c = a;
+            c /= scalar;
+            QCOMPARE(c, expectedQ);
+
+            if (scalar > 0)
+            {
+                c = a;
+                QCOMPARE(QBigNum512(c.divmod1(scalar)), expectedR);
+                QCOMPARE(c, expectedQ);
+                QCOMPARE(QBigNum512(a.mod1(scalar)), expectedR);
+            }
+        }
+    }
+
+    QBigNum512 five = 5;
+    QVERIFY_THROWS_EXCEPTION(std::overflow_error, five / int64_t(0));
+    QVERIFY_THROWS_EXCEPTION(std::overflow_error, five % int64_t(0));
+    QVERIFY_THROWS_EXCEPTION(std::overflow_error, five.divmod1(0));
+
+    mpz_clears(gmp_a, gmp_b, gmp_q, gmp_r, nullptr);
+}
+
 void TestQBigNum512::testPowMod()
 {
     QBigNum512 base("2");
@@ -956,7 +1537,337 @@ void TestQBigNum512::testPowMod()
                                "145682346723870562038756023563"), "137096311132785955879795219808");
     QCOMPARE(QBigNum512::powMod("4", "-3", "-13"), "-1");
 
+    QBigNum512 bits("0x8000000000000000000000000000000000000000000000000000000000000005");
+    QVERIFY(bits.testBit(0) && !bits.testBit(1) && bits.testBit(2) && bits.testBit(255) && !bits.testBit(256));
+    QVERIFY(QBigNum512(-1).testBit(511));
+
+    /* Every window width, a -ve modulus goes through the plain mulMod path and must agree with its +ve twin */
+    for (int k = 0; k < 40; k++)
+    {
+        QBigNum512 m = QBigNum512::randomize(QRandomGenerator::global()->bounded(400) + 2, false);
+        QBigNum512 b = QBigNum512::randomize(QRandomGenerator::global()->bounded(511) + 1, k & 1);
+        QBigNum512 e = (k == 0) ? QBigNum512(0) : QBigNum512::randomize(QRandomGenerator::global()->bounded(510) + 1, false);
+        if (m < 2)
+        {
+            continue;
+        }
+        QBigNum512 positive = QBigNum512::powMod(b, e, m);
+        QCOMPARE(QBigNum512::powMod(b, e, -m), (positive == 0) ? positive : positive - m);
+    }
+
+    /* A zero exponent gives 1 reduced by the modulus whatever its sign */
+    QCOMPARE(QBigNum512::powMod(QBigNum512("123456789"), QBigNum512(0), QBigNum512(7)), 1);
+    QCOMPARE(QBigNum512::powMod(QBigNum512("123456789"), QBigNum512(0), QBigNum512(-7)), -6);
+    QCOMPARE(QBigNum512::powMod(QBigNum512("-123456789"), QBigNum512(0), QBigNum512(1)), 0);
+    QCOMPARE(QBigNum512::powMod(QBigNum512("-123456789"), QBigNum512(0), QBigNum512(-1)), 0);
+
+
+}
+
+void TestQBigNum512::testBarrett()
+{
+    mpz_t gmp_base, gmp_exp, gmp_mod, gmp_result;
+    mpz_inits(gmp_base, gmp_exp, gmp_mod, gmp_result, nullptr);
+
+    QBigNum512 m("213452134523452345234532");
+    QBigNumBarrett<512> reducer(m);
+    QCOMPARE(reducer.modulus(), m);
+    QCOMPARE(QBigNum512::powMod(QBigNum512("15548325492384758723457862387456028374568723464"),
+                                QBigNum512("123215647465412132165465123546513521232168546432453"), reducer),
+             "46552951319514750044964");
+    QCOMPARE(QBigNumBarrett<512>(QBigNum512(13)).powMod(4, -3), 12);
+    QCOMPARE(QBigNumBarrett<512>(QBigNum512(412)).powMod(QBigNum512("-43523452"), 123), 172);
+
+    QVERIFY_THROWS_EXCEPTION(std::invalid_argument, QBigNumBarrett<512>(QBigNum512(0)));
+    QVERIFY_THROWS_EXCEPTION(std::invalid_argument, QBigNumBarrett<512>(QBigNum512(-7)));
+
+    /* Random moduli of every length, including powers of 2^64 where mu needs an extra word and the largest
+       positive modulus, against the generic division */
+    for (int k = 0; k < 300; k++)
+    {
+        QBigNum512 modulus = QBigNum512::randomize(QRandomGenerator::global()->bounded(510) + 1, false);
+        if (k % 10 == 0)
+        {
+            modulus = 1;
+            modulus <<= 64 * QRandomGenerator::global()->bounded(8);
+        }
+        else if (k % 10 == 1)
+        {
+            modulus = QBigNum512::max();
+        }
+        if (modulus <= 0)
+        {
+            continue;
+        }
+        QBigNumBarrett<512> barrett(modulus);
+
+        for (int j = 0; j < 10; j++)
+        {
+            QBigNum512 a = QBigNum512::randomize(QRandomGenerator::global()->bounded(511) + 1, QRandomGenerator::global()->generate() & 1);
+            QBigNum512 b = QBigNum512::randomize(QRandomGenerator::global()->bounded(511) + 1, QRandomGenerator::global()->generate() & 1);
+            if (j == 0)
+            {
+                a = b = modulus - 1;
+            }
+            else if (j == 1)
+            {
+                a = QBigNum512::min();
+            }
+
+            QCOMPARE(barrett.reduce(a), a % modulus);
+            QCOMPARE(barrett.mulMod(a, b), QBigNum512::mulMod(a, b, modulus));
+            QCOMPARE(QBigNum512::mulMod(a, b, barrett), QBigNum512::mulMod(a, b, modulus));
+            QCOMPARE(QBigNum512::sqrMod(a, barrett), QBigNum512::sqrMod(a, modulus));
+        }
+
+        /* powMod by a positive modulus goes through Barrett itself, so check it against GMP */
+        QBigNum512 base = QBigNum512::randomize(QRandomGenerator::global()->bounded(511) + 1, k & 1);
+        QBigNum512 exp = QBigNum512::randomize(QRandomGenerator::global()->bounded(200) + 1, false);
+        mpz_set_str(gmp_base, base.toHexString().toStdString().c_str(), 0);
+        mpz_set_str(gmp_exp, exp.toHexString().toStdString().c_str(), 0);
+        mpz_set_str(gmp_mod, modulus.toHexString().toStdString().c_str(), 0);
+        mpz_powm(gmp_result, gmp_base, gmp_exp, gmp_mod);
+        QCOMPARE(barrett.powMod(base, exp), QBigNum512::fromHex(mpz_get_str(nullptr, 16, gmp_result)));
+    }
+
+    mpz_clears(gmp_base, gmp_exp, gmp_mod, gmp_result, nullptr);
+}
+
+void TestQBigNum512::testMontgomery()
+{
+    mpz_t gmp_base, gmp_exp, gmp_mod, gmp_result;
+    mpz_inits(gmp_base, gmp_exp, gmp_mod, gmp_result, nullptr);
+
+    QBigNumMontgomery<512> mont(QBigNum512(13));
+    QCOMPARE(mont.fromMont(mont.toMont(-1)), 12);
+    QCOMPARE(mont.fromMont(mont.mul(mont.toMont(5), mont.toMont(6))), 4);
+    QCOMPARE(mont.powMod(4, -3), 12);
+    QCOMPARE(QBigNum512::powMod(QBigNum512(3), QBigNum512(1000), mont), QBigNum512::powMod(3, 1000, 13));
+
+    QVERIFY_THROWS_EXCEPTION(std::invalid_argument, QBigNumMontgomery<512>(QBigNum512(0)));
+    QVERIFY_THROWS_EXCEPTION(std::invalid_argument, QBigNumMontgomery<512>(QBigNum512(10)));
+    QVERIFY_THROWS_EXCEPTION(std::invalid_argument, QBigNumMontgomery<512>(QBigNum512(-7)));
+
+    for (int k = 0; k < 300; k++)
+    {
+        QBigNum512 modulus = QBigNum512::randomize(QRandomGenerator::global()->bounded(510) + 1, false);
+        if (k % 10 == 0)
+        {
+            modulus = QBigNum512::max();
+        }
+        else if (k % 10 == 1)
+        {
+            modulus = 1;
+            modulus <<= QRandomGenerator::global()->bounded(511);
+            modulus -= 1;
+        }
+        modulus.setBit(0);
+        QBigNumMontgomery<512> montgomery(modulus);
+
+        for (int j = 0; j < 10; j++)
+        {
+            QBigNum512 a = QBigNum512::randomize(QRandomGenerator::global()->bounded(511) + 1, QRandomGenerator::global()->generate() & 1);
+            QBigNum512 b = QBigNum512::randomize(QRandomGenerator::global()->bounded(511) + 1, QRandomGenerator::global()->generate() & 1);
+            if (j == 0)
+            {
+                a = b = modulus - 1;
+            }
+            else if (j == 1)
+            {
+                a = QBigNum512::min();
+            }
+
+            QBigNum512 am = montgomery.toMont(a);
+            QBigNum512 bm = montgomery.toMont(b);
+            QCOMPARE(montgomery.fromMont(am), a % modulus);
+            QCOMPARE(montgomery.fromMont(montgomery.mul(am, bm)), QBigNum512::mulMod(a, b, modulus));
+            QCOMPARE(montgomery.fromMont(montgomery.sqr(am)), QBigNum512::sqrMod(a, modulus));
+            QCOMPARE(montgomery.mulMod(a, b), QBigNum512::mulMod(a, b, modulus));
+            QCOMPARE(montgomery.sqrMod(a), QBigNum512::sqrMod(a, modulus));
+        }
+
+        /* Long exponents take the Montgomery path inside powMod as well, short ones stay on Barrett */
+        QBigNum512 base = QBigNum512::randomize(QRandomGenerator::global()->bounded(511) + 1, k & 1);
+        QBigNum512 exp = QBigNum512::randomize(QRandomGenerator::global()->bounded(300) + 1, false);
+        mpz_set_str(gmp_base, base.toHexString().toStdString().c_str(), 0);
+        mpz_set_str(gmp_exp, exp.toHexString().toStdString().c_str(), 0);
+        mpz_set_str(gmp_mod, modulus.toHexString().toStdString().c_str(), 0);
+        mpz_powm(gmp_result, gmp_base, gmp_exp, gmp_mod);
+        QBigNum512 expected = QBigNum512::fromHex(mpz_get_str(nullptr, 16, gmp_result));
+        QCOMPARE(montgomery.powMod(base, exp), expected);
+        QCOMPARE(QBigNum512::powMod(base, exp, modulus), expected);
+    }
+
+    mpz_clears(gmp_base, gmp_exp, gmp_mod, gmp_result, nullptr);
+}
+
+void TestQBigNum512::testMultiPowMod()
+{
+    QCOMPARE(QBigNum512::multiPowMod({2, 3}, {10, 4}, 1000), 944); // 1024 * 81 % 1000
+    QCOMPARE(QBigNum512::multiPowMod({4, 5}, {-3, 2}, 13), 1);      // 12 * 25 % 13
+    QCOMPARE(QBigNum512::multiPowMod({}, {}, 7), 1);
+    QCOMPARE(QBigNum512::multiPowMod({}, {}, -7), -6);
+    QCOMPARE(QBigNum512::multiPowMod({2, 3}, {0, 0}, -7), -6);
+    QVERIFY_THROWS_EXCEPTION(std::invalid_argument, QBigNum512::multiPowMod({2, 3}, {1}, 7));
+    QVERIFY_THROWS_EXCEPTION(std::invalid_argument, QBigNum512::multiPowMod({2}, {1}, 0));
+
+    /* Odd, even and -ve moduli, two bases both sides of the Shamir cut-over and more bases, against one
+       powMod per base */
+    for (int k = 0; k < 200; k++)
+    {
+        QBigNum512 m = QBigNum512::randomize(QRandomGenerator::global()->bounded(500) + 2, false);
+        if (m < 2)
+        {
+            continue;
+        }
+        if (k % 3 == 0)
+        {
+            m.setBit(0);
+        }
+        else if (k % 3 == 1)
+        {
+            m.clearBit(0);
+        }
+        if (k % 7 == 0)
+        {
+            m = -m;
+        }
+
+        QList<QBigNum512> bases;
+        QList<QBigNum512> exps;
+        QBigNum512 expected = 1;
+        int count = (k % 2 == 0) ? 2 : 1 + k % 5;
+        for (int j = 0; j < count; j++)
+        {
+            int bits = (k % 4 < 2) ? QRandomGenerator::global()->bounded(20) + 1 : QRandomGenerator::global()->bounded(400) + 1;
+            bases.append(QBigNum512::randomize(QRandomGenerator::global()->bounded(511) + 1, j & 1));
+            exps.append(QBigNum512::randomize(bits, false));
+            expected = QBigNum512::mulMod(expected, QBigNum512::powMod(bases[j], exps[j], m), m);
+        }
+        QCOMPARE(QBigNum512::multiPowMod(bases, exps, m), expected);
+    }
 
+    /* Two bases with full width exponents, the joint window runs at every width from 1 to 3 */
+    QBigNum512 m = QBigNum512::randomize(511, false);
+    for (int bits : {40, 41, 256, 296, 297, 511})
+    {
+        for (int k = 0; k < 4; k++)
+        {
+            if (k & 1)
+            {
+                m.setBit(0);
+            }
+            else
+            {
+                m.clearBit(0);
+            }
+            QBigNum512 x = QBigNum512::randomize(511, k & 2);
+            QBigNum512 y = QBigNum512::randomize(511, false);
+            QBigNum512 ex = QBigNum512::randomize(bits, false);
+            QBigNum512 ey = QBigNum512::randomize(bits, false);
+            ex.setBit(bits - 1);
+            QCOMPARE(QBigNum512::multiPowMod({x, y}, {ex, ey}, m), QBigNum512::mulMod(QBigNum512::powMod(x, ex, m), QBigNum512::powMod(y, ey, m), m));
+        }
+    }
+}
+
+void TestQBigNum512::testFixedBase()
+{
+    QBigNumFixedBase<512> small(QBigNum512(2), QBigNum512(1000));
+    QCOMPARE(small.pow(10), 24);
+    QCOMPARE(small.pow(0), 1);
+    QCOMPARE(QBigNumFixedBase<512>(QBigNum512(4), QBigNum512(13)).pow(-3), 12);
+
+    QVERIFY_THROWS_EXCEPTION(std::invalid_argument, QBigNumFixedBase<512>(QBigNum512(2), QBigNum512(0)));
+    QVERIFY_THROWS_EXCEPTION(std::invalid_argument, QBigNumFixedBase<512>(QBigNum512(2), QBigNum512(7), 511, 0));
+    QVERIFY_THROWS_EXCEPTION(std::invalid_argument, QBigNumFixedBase<512>::deserialize(QByteArray("QBFB")));
+    QVERIFY_THROWS_EXCEPTION(std::invalid_argument, QBigNumFixedBase<256>::deserialize(small.serialize()));
+
+    /* Odd and even moduli and a spread of comb shapes, the loaded copy must give the same answers */
+    for (int k = 0; k < 60; k++)
+    {
+        QBigNum512 m = QBigNum512::randomize(QRandomGenerator::global()->bounded(509) + 2, false);
+        if (k & 1)
+        {
+            m.setBit(0);
+        }
+        if (m < 2)
+        {
+            continue;
+        }
+        QBigNum512 g = QBigNum512::randomize(QRandomGenerator::global()->bounded(511) + 1, k & 2);
+        int maxExpBits = QRandomGenerator::global()->bounded(511) + 1;
+        int teeth = 1 + k % 8;
+        int blocks = qMin(1 + k % 3, maxExpBits);
+
+        QBigNumFixedBase<512> fixed(g, m, maxExpBits, teeth, blocks);
+        QBigNumFixedBase<512> loaded = QBigNumFixedBase<512>::deserialize(fixed.serialize());
+        QCOMPARE(loaded.base(), g);
+        QCOMPARE(loaded.modulus(), m);
+        for (int j = 0; j < 10; j++)
+        {
+            /* Some exponents run past maxExpBits and take the powMod fallback */
+            QBigNum512 e = QBigNum512::randomize(QRandomGenerator::global()->bounded(511) + 1, false);
+            QBigNum512 expected = QBigNum512::powMod(g, e, m);
+            QCOMPARE(fixed.pow(e), expected);
+            QCOMPARE(loaded.pow(e), expected);
+        }
+    }
+}
+
+void TestQBigNum512::testSpecialModulus()
+{
+    QBigNum512 p25519 = (QBigNum512(1) << 255) - 19;
+    QBigNum512 p256("0xffffffff00000001000000000000000000000000ffffffffffffffffffffffff");
+    QBigNumSolinas<512> pseudoMersenne(p25519);
+    QBigNumSolinas<512> solinas(256, {{224, 1}, {192, -1}, {96, -1}, {0, 1}});
+    QCOMPARE(pseudoMersenne.modulus(), p25519);
+    QCOMPARE(solinas.modulus(), p256);
+    QCOMPARE(pseudoMersenne.reduce(QBigNum512(-1)), p25519 - 1);
+    QCOMPARE(QBigNum512::powMod(QBigNum512(2), QBigNum512(255), pseudoMersenne), 19);
+
+    QVERIFY_THROWS_EXCEPTION(std::invalid_argument, QBigNumSolinas<512>(p256));
+    QVERIFY_THROWS_EXCEPTION(std::invalid_argument, QBigNumSolinas<512>(QBigNum512(0)));
+    QVERIFY_THROWS_EXCEPTION(std::invalid_argument, QBigNumSolinas<512>(512, {{0, 1}}));
+    QVERIFY_THROWS_EXCEPTION(std::invalid_argument, QBigNumSolinas<512>(256, {{255, 1}}));
+
+    /* The three primes plus random pseudo Mersenne, mixed sign and word aligned forms, the last take the one
+       pass word reduction, against the generic reduction */
+    QBigNumSolinas<512> p384(384, {{128, 1}, {96, 1}, {32, -1}, {0, 1}});
+    QCOMPARE(p384.modulus(), QBigNum512("0xfffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffeffffffff0000000000000000ffffffff"));
+    for (int k = 0; k < 100; k++)
+    {
+        int bits = QRandomGenerator::global()->bounded(500) + 8;
+        int words = QRandomGenerator::global()->bounded(15) + 1;
+        QBigNumSolinas<512> special = (k == 0) ? pseudoMersenne : (k == 1) ? solinas : (k == 2) ? p384 : (k & 1)
+            ? QBigNumSolinas<512>((QBigNum512(1) << bits) - QBigNum512::randomize(QRandomGenerator::global()->bounded(qMin(62, bits - 2)) + 1, false) - 1)
+            : (k % 4 == 2)
+            ? QBigNumSolinas<512>(32 * words, {{32 * QRandomGenerator::global()->bounded(words), (k & 8) ? -1 : 3},
+                                               {32 * QRandomGenerator::global()->bounded(words), (k & 16) ? 2 : -1}, {0, (k & 4) ? -1 : 1}})
+            : QBigNumSolinas<512>(bits, {{QRandomGenerator::global()->bounded(bits - 4), (k & 2) ? -1 : 1}, {0, (k & 4) ? -3 : 5}});
+        QBigNum512 m = special.modulus();
+
+        for (int j = 0; j < 10; j++)
+        {
+            QBigNum512 a = QBigNum512::randomize(QRandomGenerator::global()->bounded(511) + 1, QRandomGenerator::global()->generate() & 1);
+            QBigNum512 b = QBigNum512::randomize(QRandomGenerator::global()->bounded(511) + 1, QRandomGenerator::global()->generate() & 1);
+            if (j == 0)
+            {
+                a = b = m - 1;
+            }
+            else if (j == 1)
+            {
+                a = QBigNum512::min();
+            }
+            QCOMPARE(special.reduce(a), a % m);
+            QCOMPARE(QBigNum512::mulMod(a, b, special), QBigNum512::mulMod(a, b, m));
+            QCOMPARE(QBigNum512::sqrMod(a, special), QBigNum512::sqrMod(a, m));
+        }
+
+        QBigNum512 base = QBigNum512::randomize(QRandomGenerator::global()->bounded(511) + 1, k & 1);
+        QBigNum512 exp = QBigNum512::randomize(QRandomGenerator::global()->bounded(300) + 1, false);
+        QCOMPARE(QBigNum512::powMod(base, exp, special), QBigNum512::powMod(base, exp, m));
+    }
 }
 
 void TestQBigNum512::testInverseMod()
@@ -1010,10 +1921,102 @@ void TestQBigNum512::testInverseMod()
         QVERIFY_THROWS_EXCEPTION(std::invalid_argument, a.inverseMod(mod)); // Modulus cannot be zero
     }
 
+    // Test 8: Zero has no inverse, for odd and even moduli
+    {
+        QVERIFY_THROWS_EXCEPTION(std::invalid_argument, QBigNum512(0).inverseMod(QBigNum512("1000003")));
+        QVERIFY_THROWS_EXCEPTION(std::invalid_argument, QBigNum512(0).inverseMod(QBigNum512("1000004")));
+    }
+
+    // Test 9: Random multi word moduli, odd ones take the binary gcd and even ones extended Euclid
+    for (int k = 0; k < 500; k++)
+    {
+        QBigNum512 mod = QBigNum512::randomize(1 + QRandomGenerator::global()->bounded(510), false) + 2;
+        QBigNum512 a = QBigNum512::randomize(1 + QRandomGenerator::global()->bounded(510), k & 1);
+        if (QBigNum512::gcd(a, mod) != 1)
+        {
+            QVERIFY_THROWS_EXCEPTION(std::invalid_argument, a.inverseMod(mod));
+            continue;
+        }
+        QBigNum512 inverse = a.inverseMod(mod);
+        QVERIFY(inverse >= 0 && inverse < mod);
+        QCOMPARE(QBigNum512::mulMod(a, inverse, mod), 1);
+    }
+
     QCOMPARE(QBigNum512("4").inverseMod(13), 10);
     QCOMPARE(QBigNum512("4").inverseMod(-13), -3);
 }
 
+void TestQBigNum512::testBatchInverseMod()
+{
+    QBigNum512 p("115792089237316195423570985008687907853269984665640564039457584007908834671663");
+
+    // Zeros and multiples of p come back 0 without poisoning the other entries
+    QList<QBigNum512> values;
+    values << 3 << 0 << QBigNum512(-7) << p * 5 << QBigNum512::randomize(400, false) << 1 << 0;
+    QList<QBigNum512> inverses = values;
+    QBigNum512::batchInverseMod(inverses, p);
+    for (int i = 0; i < values.size(); i++)
+    {
+        if (values[i] % p == 0)
+        {
+            QCOMPARE(inverses[i], 0);
+            continue;
+        }
+        QCOMPARE(inverses[i], values[i].inverseMod(p));
+    }
+
+    // A -ve modulus gives the same results as inverseMod
+    inverses = values;
+    QBigNum512::batchInverseMod(inverses, -p);
+    QCOMPARE(inverses[0], QBigNum512(3).inverseMod(-p));
+    QCOMPARE(inverses[2], QBigNum512(-7).inverseMod(-p));
+    QCOMPARE(inverses[3], 0);
+
+    // Empty and all zero batches are left alone
+    QList<QBigNum512> empty;
+    QBigNum512::batchInverseMod(empty, p);
+    QVERIFY(empty.isEmpty());
+    QList<QBigNum512> zeros;
+    zeros << 0 << p;
+    QBigNum512::batchInverseMod(zeros, p);
+    QCOMPARE(zeros[0], 0);
+    QCOMPARE(zeros[1], 0);
+
+    // An entry sharing a factor with the modulus has no inverse, the throw names it and leaves the list alone
+    QList<QBigNum512> shared;
+    shared << 3 << QBigNum512(-7) << 6 << 9;
+    QList<QBigNum512> before = shared;
+    QVERIFY_THROWS_EXCEPTION(std::invalid_argument, QBigNum512::batchInverseMod(shared, 1000));
+    QCOMPARE(shared, before);
+    try
+    {
+        QBigNum512::batchInverseMod(shared, 1000);
+        QFAIL("batchInverseMod should have thrown");
+    }
+    catch (const std::invalid_argument& e)
+    {
+        QCOMPARE(QString(e.what()), QString("Inverse does not exist for entry 2."));
+    }
+    QVERIFY_THROWS_EXCEPTION(std::invalid_argument, QBigNum512::batchInverseMod(values, 0));
+
+    // A longer batch against inverseMod one at a time, even modulus included
+    for (QBigNum512 m : {p, QBigNum512::randomize(300, false) * 2 + 2})
+    {
+        QList<QBigNum512> batch;
+        for (int i = 0; i < 50; i++)
+        {
+            QBigNum512 x = QBigNum512::randomize(1 + QRandomGenerator::global()->bounded(510), i & 1);
+            batch << ((QBigNum512::gcd(x, m) == 1) ? x : QBigNum512(1));
+        }
+        QList<QBigNum512> result = batch;
+        QBigNum512::batchInverseMod(result, m);
+        for (int i = 0; i < batch.size(); i++)
+        {
+            QCOMPARE(result[i], batch[i].inverseMod(m));
+        }
+    }
+}
+
 void TestQBigNum512::testGCD()
 {
     QCOMPARE(QBigNum512::gcd(23422, 234234), 14);
@@ -1028,6 +2031,21 @@ void TestQBigNum512::testGCD()
     QCOMPARE(QBigNum512::gcd(23423, 234234), 1);
     QCOMPARE(QBigNum512::gcd("-2342452345728345782364578236452",
                              "23423523745982374695872364534252333224"), 4);
+    QCOMPARE(QBigNum512::gcd(0, -234234), -234234);
+    QCOMPARE(QBigNum512::gcd(QBigNum512(3) << 200, QBigNum512(6) << 130), QBigNum512(3) << 131);
+    QCOMPARE(QBigNum512::gcd(QBigNum512::max(), QBigNum512::max() - 2), 1);
+
+    // Consecutive Fibonacci numbers take the most subtract steps
+    QBigNum512 f0 = 1;
+    QBigNum512 f1 = 1;
+    while (f1.bitLength() < 480)
+    {
+        QBigNum512 next = f0 + f1;
+        f0 = f1;
+        f1 = next;
+    }
+    QCOMPARE(QBigNum512::gcd(f0, f1), 1);
+    QCOMPARE(QBigNum512::gcd(f0 * 12345, f1 * 12345), 12345);
 
     // Number of iterations for the test
     constexpr int iterations = 30000;
@@ -1099,6 +2117,167 @@ void TestQBigNum512::testGCD()
     qDebug() <<  "gcd" << iterations << "iterations:" << elapsed << "ms";
 }
 
+void TestQBigNum512::testHalfGcd()
+{
+    using Big = QBigNum<4160>;
+    mpz_t gmp_a, gmp_b, gmp_r;
+    mpz_inits(gmp_a, gmp_b, gmp_r, nullptr);
+
+    for (int k = 0; k < 60; k++)
+    {
+        Big a = Big::randomize(QRandomGenerator::global()->bounded(4095) + 1, k & 1);
+        Big b = Big::randomize(QRandomGenerator::global()->bounded(4094) + 1, k & 2);
+        if (k % 3 == 0)
+        {
+            /* A wide common factor keeps the gcd itself above the threshold */
+            Big c = Big::randomize(QRandomGenerator::global()->bounded(2000) + 1, false);
+            a = (a >> 2048) * c;
+            b = (b >> 2048) * c;
+        }
+
+        mpz_set_str(gmp_a, a.toHexString().toStdString().c_str(), 0);
+        mpz_set_str(gmp_b, b.toHexString().toStdString().c_str(), 0);
+        mpz_gcd(gmp_r, gmp_a, gmp_b);
+        if (a != 0 && b != 0)
+        {
+            QCOMPARE(Big::gcd(a, b).toHexString(), Big(QString(mpz_get_str(nullptr, 10, gmp_r))).toHexString());
+        }
+
+        /* Odd moduli reach the half gcd inverse */
+        Big m = Big::abs(b) * 2 + 1;
+        mpz_mul_2exp(gmp_b, gmp_b, 1);
+        mpz_abs(gmp_b, gmp_b);
+        mpz_add_ui(gmp_b, gmp_b, 1);
+        if (mpz_invert(gmp_r, gmp_a, gmp_b))
+        {
+            QCOMPARE(a.inverseMod(m).toHexString(), Big(QString(mpz_get_str(nullptr, 10, gmp_r))).toHexString());
+        }
+        else
+        {
+            QVERIFY_THROWS_EXCEPTION(std::invalid_argument, a.inverseMod(m));
+        }
+    }
+
+    mpz_clears(gmp_a, gmp_b, gmp_r, nullptr);
+}
+
+void TestQBigNum512::testPowModSpeed()
+{
+    // Number of iterations for the test
+    constexpr int iterations = 200;
+    QList<QBigNum512> bases, exps, mods;
+    for (int k = 0; k < iterations; k++)
+    {
+        bases.append(QBigNum512::randomize(511, false));
+        exps.append(QBigNum512::randomize(511, false));
+        QBigNum512 mod = QBigNum512::randomize(511, false);
+        mod.setBit(510);
+        mods.append(mod);
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    for (int k = 0; k < iterations; k++)
+    {
+        auto result = QBigNum512::powMod(bases[k], exps[k], mods[k]);
+        QVERIFY(result >= 0 && result < mods[k]);
+    }
+    qDebug() << "powMod" << iterations << "iterations of 511 bit numbers:" << timer.elapsed() << "ms";
+}
+
+void TestQBigNum512::testMulCrossover()
+{
+    /* One level of each algorithm over the tier below it, the thresholds should sit where it starts winning */
+    constexpr int maxWords = 384;
+    std::array<uint64_t, maxWords> a, b;
+    std::array<uint64_t, 2 * maxWords> result;
+    std::array<uint64_t, QBigNumKernels::mulScratchSize(maxWords)> scratch;
+    for (int i = 0; i < maxWords; i++)
+    {
+        a[i] = QRandomGenerator::global()->generate64();
+        b[i] = QRandomGenerator::global()->generate64();
+    }
+
+    for (int n : {8, 12, 16, 24, 32, 48, 64, 96, 128})
+    {
+        int iterations = 2000000 / (n * n);
+        QElapsedTimer timer;
+        timer.start();
+        for (int k = 0; k < iterations; k++)
+        {
+            QBigNumKernels::mulSchoolbook(result.data(), a.data(), n, b.data(), n);
+            a[0] ^= result[n];
+        }
+        qint64 schoolbook = timer.nsecsElapsed();
+
+        timer.restart();
+        for (int k = 0; k < iterations; k++)
+        {
+            QBigNumKernels::mulKaratsuba(result.data(), a.data(), b.data(), n, scratch.data(), {n, n});
+            a[0] ^= result[n];
+        }
+        qint64 karatsuba = timer.nsecsElapsed();
+
+        qDebug() << n << "words, schoolbook:" << schoolbook / iterations << "ns karatsuba:" << karatsuba / iterations << "ns";
+    }
+
+    const QBigNumKernels::MulThresholds karatsubaOnly{QBIGNUM_KARATSUBA_THRESHOLD, std::numeric_limits<int>::max()};
+    for (int n : {48, 64, 96, 128, 192, 256, 384})
+    {
+        int iterations = 20000000 / (n * n);
+        QElapsedTimer timer;
+        timer.start();
+        for (int k = 0; k < iterations; k++)
+        {
+            QBigNumKernels::mulBalanced(result.data(), a.data(), b.data(), n, scratch.data(), karatsubaOnly);
+            a[0] ^= result[n];
+        }
+        qint64 karatsuba = timer.nsecsElapsed();
+
+        timer.restart();
+        for (int k = 0; k < iterations; k++)
+        {
+            QBigNumKernels::mulToom3(result.data(), a.data(), b.data(), n, scratch.data(), {QBIGNUM_KARATSUBA_THRESHOLD, n});
+            a[0] ^= result[n];
+        }
+        qint64 toom3 = timer.nsecsElapsed();
+
+        qDebug() << n << "words, karatsuba:" << karatsuba / iterations << "ns toom3:" << toom3 / iterations << "ns";
+    }
+
+    /* The NTT only pays off near the top of each power of two transform length, so time the sizes that fill one */
+    const QBigNumKernels::MulThresholds toom3Only{QBIGNUM_KARATSUBA_THRESHOLD, QBIGNUM_TOOM3_THRESHOLD};
+    constexpr int maxNttWords = 65536;
+    std::vector<uint64_t> x(maxNttWords), y(maxNttWords), product(2 * maxNttWords), nttScratch(QBigNumKernels::mulScratchSize(maxNttWords));
+    for (int i = 0; i < maxNttWords; i++)
+    {
+        x[i] = QRandomGenerator::global()->generate64();
+        y[i] = QRandomGenerator::global()->generate64();
+    }
+    for (int n : {16384, 32768, 65536})
+    {
+        int iterations = 2 * maxNttWords / n;
+        QElapsedTimer timer;
+        timer.start();
+        for (int k = 0; k < iterations; k++)
+        {
+            QBigNumKernels::mulBalanced(product.data(), x.data(), y.data(), n, nttScratch.data(), toom3Only);
+            x[0] ^= product[n];
+        }
+        qint64 toom3 = timer.nsecsElapsed();
+
+        timer.restart();
+        for (int k = 0; k < iterations; k++)
+        {
+            QBigNumKernels::mulNtt(product.data(), x.data(), n, y.data(), n);
+            x[0] ^= product[n];
+        }
+        qint64 ntt = timer.nsecsElapsed();
+
+        qDebug() << n << "words, toom3:" << toom3 / iterations << "ns ntt:" << ntt / iterations << "ns";
+    }
+}
+
 void TestQBigNum512::testMillerRabin()
 {
     // Number of iterations for the test
@@ -1128,6 +2307,66 @@ void TestQBigNum512::testMillerRabin()
     qDebug() << "found" << iterations << "random primes of length upto" << maxNbits << "bits in" << timer.elapsed() << "ms";
 }
 
+void TestQBigNum512::testJacobi()
+{
+    // Test 1: Known values, including the Kronecker extension to even and negative n
+    QCOMPARE(QBigNum512::jacobi(1001, 9907), -1);
+    QCOMPARE(QBigNum512::jacobi(19, 45), 1);
+    QCOMPARE(QBigNum512::jacobi(8, 21), -1);
+    QCOMPARE(QBigNum512::jacobi(5, 21), 1);
+    QCOMPARE(QBigNum512::jacobi(6, 21), 0);
+    QCOMPARE(QBigNum512::jacobi(0, 1), 1);
+    QCOMPARE(QBigNum512::jacobi(3, 8), -1);
+    QCOMPARE(QBigNum512::jacobi(-1, -5), -1);
+    QCOMPARE(QBigNum512::jacobi(-1, 0), 1);
+    QCOMPARE(QBigNum512::jacobi(2, 0), 0);
+
+    // Test 2: Every pair of small values against GMP
+    mpz_t gmp_a, gmp_n;
+    mpz_inits(gmp_a, gmp_n, nullptr);
+    for (int a = -40; a <= 40; a++)
+    {
+        for (int n = -40; n <= 40; n++)
+        {
+            mpz_set_si(gmp_a, a);
+            mpz_set_si(gmp_n, n);
+            QCOMPARE(QBigNum512::jacobi(a, n), mpz_kronecker(gmp_a, gmp_n));
+        }
+    }
+
+    // Test 3: Random values of any size and sign against GMP, with shared factors and very different lengths
+    for (int k = 0; k < 2000; k++)
+    {
+        QBigNum512 a = QBigNum512::randomize(QRandomGenerator::global()->bounded(511) + 1, k & 1);
+        QBigNum512 n = QBigNum512::randomize(QRandomGenerator::global()->bounded(511) + 1, k & 2);
+        if (k % 5 == 0)
+        {
+            QBigNum512 c = QBigNum512::randomize(30, false);
+            a = (a >> 64) * c;
+            n = (n >> 64) * c;
+        }
+        else if (k % 5 == 1)
+        {
+            a = QBigNum512::randomize(QRandomGenerator::global()->bounded(16) + 1, k & 4);
+        }
+        mpz_set_str(gmp_a, a.toHexString().toStdString().c_str(), 0);
+        mpz_set_str(gmp_n, n.toHexString().toStdString().c_str(), 0);
+        QCOMPARE(QBigNum512::jacobi(a, n), mpz_kronecker(gmp_a, gmp_n));
+    }
+    mpz_clears(gmp_a, gmp_n, nullptr);
+
+    // Test 4: For an odd prime legendre agrees with Euler's criterion
+    const QBigNum512 p("0xfffffffffffffffffffffffffffffffffffffffffffffffffffffffefffffc2f");
+    for (int k = 0; k < 50; k++)
+    {
+        QBigNum512 a = QBigNum512::randomize(256, false) % p;
+        QBigNum512 euler = QBigNum512::powMod(a, (p - 1).div(2), p);
+        QVERIFY(euler == 0 || euler == 1 || euler == p - 1);
+        QCOMPARE(QBigNum512::legendre(a, p), (euler == 0) ? 0 : (euler == 1) ? 1 : -1);
+    }
+    QCOMPARE(QBigNum512::legendre(p * 3, p), 0);
+}
+
 void TestQBigNum512::testTonelli()
 {
     // Number of iterations for the test